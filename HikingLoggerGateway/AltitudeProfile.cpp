@@ -0,0 +1,237 @@
+/*
+*	AltitudeProfile.cpp, Copyright Jonathan Mackey 2023
+*	Draws the altitude profile of a hike from its log entries.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#include "AltitudeProfile.h"
+#include "HikeLog.h"
+#include "DisplayController.h"
+#include "XFont.h"
+
+const uint8_t	kEntriesPerRead = 10;
+/*
+*	The number of reads per Update is limited so that a long hike doesn't
+*	block the UI (and the radio) till all of its entries are read.  The
+*	remaining entries are read by the following updates.
+*/
+const uint8_t	kReadsPerUpdate = 4;
+/*
+*	The scale is extended in steps of 128 (256 Pa, about 21m) so that it
+*	doesn't change (and the graph isn't redrawn) with every new low or high.
+*/
+const uint16_t	kScaleStep = 128;
+const uint16_t	kLineColor = XFont::eYellow;
+const uint16_t	kAreaColor = 0x01E7;	// Dark yellow
+
+/****************************** AltitudeProfile *******************************/
+AltitudeProfile::AltitudeProfile(void)
+	: mHikeLog(nullptr), mDisplay(nullptr), mNextEntryPos(0), mColumnCount(0),
+	  mTop(0), mRows(0), mHasBacklog(false)
+{
+}
+
+/********************************* Initialize *********************************/
+void AltitudeProfile::Initialize(
+	HikeLog*			inHikeLog,
+	DisplayController*	inDisplay)
+{
+	mHikeLog = inHikeLog;
+	mDisplay = inDisplay;
+}
+
+/*********************************** Start ************************************/
+void AltitudeProfile::Start(
+	uint32_t	inEntriesPos,
+	uint8_t		inTop,
+	uint8_t		inRows)
+{
+	mNextEntryPos = inEntriesPos;
+	mTop = inTop;
+	mRows = inRows;
+	mColumnCount = 0;
+	mEntriesPerColumn = 1;
+	mColumnEntries = 1;		// So that the first entry starts a column
+	mScaleMin = 0xFFFF;
+	mScaleMax = 0;
+	mLevelShift = 0;
+	mFirstChanged = kColumns;
+	mRedrawAll = true;
+	mHasBacklog = false;
+}
+
+/*********************************** Update ***********************************/
+void AltitudeProfile::Update(void)
+{
+	if (mNextEntryPos)
+	{
+		SHikeLogEntry	entry[kEntriesPerRead];
+		uint8_t	entriesRead = 0;
+		for (uint8_t reads = 0; reads < kReadsPerUpdate; reads++)
+		{
+			entriesRead = mHikeLog->ReadEntries(mNextEntryPos, entry, kEntriesPerRead);
+			for (uint8_t i = 0; i < entriesRead; i++)
+			{
+				AddEntry(entry[i].pressure >> 1);
+			}
+			// A short read means the end of the log has been reached.
+			if (entriesRead < kEntriesPerRead)
+			{
+				break;
+			}
+		}
+		mHasBacklog = entriesRead == kEntriesPerRead;
+	}
+	if (mRedrawAll)
+	{
+		mFirstChanged = 0;
+	}
+	for (uint16_t column = mFirstChanged; column < mColumnCount; column++)
+	{
+		DrawColumn(column);
+	}
+	/*
+	*	Erase the unused columns.
+	*/
+	if (mRedrawAll &&
+		mColumnCount < kColumns)
+	{
+		mDisplay->MoveTo(mTop, mColumnCount);
+		mDisplay->FillBlock(mRows, kColumns - mColumnCount, XFont::eBlack);
+	}
+	mFirstChanged = kColumns;
+	mRedrawAll = false;
+}
+
+/********************************** AddEntry **********************************/
+void AltitudeProfile::AddEntry(
+	uint16_t	inPressure)
+{
+	if (inPressure < mScaleMin ||
+		inPressure >= mScaleMax)
+	{
+		SetScale(inPressure < mScaleMin ? (inPressure & ~(kScaleStep-1)) : mScaleMin,
+				 inPressure >= mScaleMax ? ((inPressure | (kScaleStep-1)) + 1) : mScaleMax);
+	}
+	uint8_t		level = (inPressure - mScaleMin) >> mLevelShift;
+	uint16_t	column = mColumnCount - 1;
+	if (mColumnEntries >= mEntriesPerColumn)
+	{
+		if (mColumnCount == kColumns)
+		{
+			MergeColumns();
+		}
+		column = mColumnCount;
+		mColumnCount++;
+		mColumn[column].minLevel = level;
+		mColumn[column].maxLevel = level;
+		mColumnEntries = 1;
+	} else
+	{
+		if (level < mColumn[column].minLevel)
+		{
+			mColumn[column].minLevel = level;
+		} else if (level > mColumn[column].maxLevel)
+		{
+			mColumn[column].maxLevel = level;
+		}
+		mColumnEntries++;
+	}
+	if (column < mFirstChanged)
+	{
+		mFirstChanged = column;
+	}
+}
+
+/********************************** SetScale **********************************/
+/*
+*	The scale only grows and its ends are multiples of kScaleStep, so
+*	mLevelShift never decreases and mScaleMin moves by a multiple of
+*	1 << mLevelShift.  The remapped levels are therefore the same as the
+*	levels that would have been calculated from the pressures.
+*/
+void AltitudeProfile::SetScale(
+	uint16_t	inScaleMin,
+	uint16_t	inScaleMax)
+{
+	uint8_t	levelShift = 0;
+	while (((inScaleMax - inScaleMin - 1) >> levelShift) > 0xFF)
+	{
+		levelShift++;
+	}
+	for (uint16_t column = 0; column < mColumnCount; column++)
+	{
+		SMinMax&	minMax = mColumn[column];
+		minMax.minLevel = (((uint16_t)minMax.minLevel << mLevelShift) + (mScaleMin - inScaleMin)) >> levelShift;
+		minMax.maxLevel = (((uint16_t)minMax.maxLevel << mLevelShift) + (mScaleMin - inScaleMin)) >> levelShift;
+	}
+	mScaleMin = inScaleMin;
+	mScaleMax = inScaleMax;
+	mLevelShift = levelShift;
+	mRedrawAll = true;
+}
+
+/******************************** MergeColumns ********************************/
+/*
+*	Merges each pair of columns into one.  This is only called when the last
+*	column is full, so the last merged column is also full.
+*/
+void AltitudeProfile::MergeColumns(void)
+{
+	for (uint16_t column = 0; column < kColumns/2; column++)
+	{
+		const SMinMax*	pair = &mColumn[column*2];
+		uint8_t	minLevel = pair[0].minLevel < pair[1].minLevel ?
+								pair[0].minLevel : pair[1].minLevel;
+		uint8_t	maxLevel = pair[0].maxLevel > pair[1].maxLevel ?
+								pair[0].maxLevel : pair[1].maxLevel;
+		mColumn[column].minLevel = minLevel;
+		mColumn[column].maxLevel = maxLevel;
+	}
+	mColumnCount = kColumns/2;
+	mEntriesPerColumn *= 2;
+	mColumnEntries = mEntriesPerColumn;
+	mRedrawAll = true;
+}
+
+/********************************* LevelToRow *********************************/
+uint8_t AltitudeProfile::LevelToRow(
+	uint8_t	inLevel) const
+{
+	return(mTop + (uint8_t)(((uint32_t)inLevel << mLevelShift) * mRows/
+									(mScaleMax - mScaleMin)));
+}
+
+/********************************* DrawColumn *********************************/
+/*
+*	Each column is drawn as 3 vertical spans: the background above the
+*	profile, the range of the entries in the column, and the area below.
+*/
+void AltitudeProfile::DrawColumn(
+	uint16_t	inColumn)
+{
+	uint8_t	lineTop = LevelToRow(mColumn[inColumn].minLevel);
+	uint8_t	lineBottom = LevelToRow(mColumn[inColumn].maxLevel) + 1;
+	mDisplay->MoveTo(mTop, inColumn);
+	mDisplay->FillBlock(lineTop - mTop, 1, XFont::eBlack);
+	mDisplay->MoveTo(lineTop, inColumn);
+	mDisplay->FillBlock(lineBottom - lineTop, 1, kLineColor);
+	mDisplay->MoveTo(lineBottom, inColumn);
+	mDisplay->FillBlock(mTop + mRows - lineBottom, 1, kAreaColor);
+}
@@ -0,0 +1,118 @@
+/*
+*	AltitudeProfile.h, Copyright Jonathan Mackey 2023
+*	Draws the altitude profile of a hike from its log entries.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef AltitudeProfile_h
+#define AltitudeProfile_h
+
+#include <inttypes.h>
+
+class HikeLog;
+class DisplayController;
+
+/*
+*	The log entries are decimated as they're read into a buffer holding the
+*	minimum and maximum pressure of each display column.  Initially each
+*	column holds one entry.  When all of the columns are used, adjacent pairs
+*	of columns are merged, and each column then holds twice as many entries.
+*	The entries are only read once, so as a running hike is logged only the
+*	new entries are read and only the columns they change are drawn.  The
+*	whole graph is redrawn from the buffer when the columns are merged or the
+*	scale changes.
+*
+*	Pressure is plotted rather than altitude.  Over the range of a hike
+*	altitude is close enough to linear with pressure, and this avoids the
+*	floating point altitude calculation per entry.  Lower pressure (higher
+*	altitude) is drawn closer to the top.
+*
+*	To halve the SRAM used, the buffer holds each pressure as an 8 bit level:
+*	its offset from the top of the scale (mScaleMin) shifted right by
+*	mLevelShift.  mLevelShift is the smallest shift that fits the scale in
+*	256 levels, so the levels are exact till the scale exceeds 512 Pa (about
+*	43m) and there are always at least 128 levels over the scale.  When the
+*	scale changes the levels are remapped.  The buffer is kColumns x 2 bytes
+*	(480 bytes) of SRAM.
+*/
+class AltitudeProfile
+{
+public:
+							AltitudeProfile(void);
+	void					Initialize(
+								HikeLog*				inHikeLog,
+								DisplayController*		inDisplay);
+							/*
+							*	Start: Clears the graph and sets the log
+							*	entries to graph.  inEntriesPos is a position
+							*	returned by HikeLog ActiveLogEntriesPos or
+							*	FindLogEntries.  The graph is drawn in the
+							*	rows inTop to inTop + inRows - 1.
+							*/
+	void					Start(
+								uint32_t				inEntriesPos,
+								uint8_t					inTop,
+								uint8_t					inRows);
+							/*
+							*	Update: Reads up to 40 of the entries logged
+							*	since the last update and draws what changed.
+							*	HasBacklog returns true when the last Update
+							*	stopped before the end of the log.
+							*/
+	void					Update(void);
+	bool					HasBacklog(void) const
+								{return(mHasBacklog);}
+	bool					HasEntries(void) const
+								{return(mColumnCount != 0);}
+protected:
+	static const uint16_t	kColumns = 240;
+	struct SMinMax
+	{
+		uint8_t		minLevel;
+		uint8_t		maxLevel;
+	};
+	HikeLog*			mHikeLog;
+	DisplayController*	mDisplay;
+	uint32_t	mNextEntryPos;
+	SMinMax		mColumn[kColumns];
+	uint16_t	mColumnCount;		// Columns used
+	uint16_t	mEntriesPerColumn;
+	uint16_t	mColumnEntries;		// Entries in the last column
+	uint16_t	mFirstChanged;		// First column to draw, kColumns if none
+	uint16_t	mScaleMin;			// Pressure drawn at mTop
+	uint16_t	mScaleMax;			// Pressure drawn below the last row
+	uint8_t		mLevelShift;		// Level = (pressure - mScaleMin) >> mLevelShift
+	uint8_t		mTop;
+	uint8_t		mRows;
+	bool		mRedrawAll;
+	bool		mHasBacklog;
+
+	void					AddEntry(
+								uint16_t				inPressure);
+	void					SetScale(
+								uint16_t				inScaleMin,
+								uint16_t				inScaleMax);
+	void					MergeColumns(void);
+	void					DrawColumn(
+								uint16_t				inColumn);
+	uint8_t					LevelToRow(
+								uint8_t					inLevel) const;
+};
+
+#endif // AltitudeProfile_h
@@ -24,40 +24,30 @@
 #include <EEPROM.h>
 #include <string.h>
 #include "HikeLog.h"
+#include "StorageLayout.h"
 #include "UnixTime.h"
 #include "LogTempPres.h"
 #include "DataStream.h"
+#include "CRC16.h"
 #include "SdFat.h"
+#include <stddef.h>
 
 const uint32_t kLogInterval = 4;	// Seconds
 const uint8_t kNumEntriesPerPass = 10;
 const char kFileExtStr[] PROGMEM = ".log";
+const char kCorruptFileExtStr[] PROGMEM = ".bad";	// Header failed its CRC check
 const char kSummariesFilenameStr[] PROGMEM = "HikeSum.bin";
 const uint32_t	kLogFileMarker = 0x484C4F47;	// HLOG
 
-const uint8_t kStartingLocEEAddr = 4;	// uint16_t
-const uint8_t kEndingLocEEAddr = 6;	// uint16_t
-const uint8_t kLogInitializedEEAddr = 8;
-const uint16_t kMaxHikeSummaries = 125;	// sizeof(SHikeSummary) * kMaxHikeSummaries = 2000
-/*
-*	EEPROM usage, 2K bytes (assumes ATmega644PA, E2END = 0x7FF)
-*
-*	[0]		uint8_t		networkID;
-*	[1]		uint8_t		nodeID;
-*	[2]		uint8_t		unassigned[2];
-*	[4]		uint16_t	lastStartingLocIndex;
-*	[6]		uint16_t	lastEndingLocIndex;
-*	[8]		uint8_t		logInitialized;
-*	[9]		uint8_t		unassigned2[23];
-*	Storage of the last 100 hikes, circular storage, 16 byte struct
-*	[32]	uint16_t	lastHikesHead
-*	[34]	uint16_t	lastHikesTail
-*	[36]	uint8_t		unassigned3[2];
-*	[38]	SHikeSummary hikes[kMaxHikeSummaries];  size = 16 bytes per hike
-*	[2038]	uint8_t		unassigned4[10];
-*/
-const uint8_t kLogRingAddressesEEAddr = 32;
-const uint8_t kLogRingStorageEEAddr = 38;
+// See StorageLayout.h for the MCU's EEPROM usage.
+const uint16_t kStartingLocEEAddr = Layout::kStartingLocIndex.start;	// uint16_t
+const uint16_t kEndingLocEEAddr = Layout::kEndingLocIndex.start;	// uint16_t
+const uint16_t kLogInitializedEEAddr = Layout::kLogInitialized.start;
+const uint16_t kMaxHikeSummaries = Layout::kMaxHikeSummaries;	// sizeof(SHikeSummary) * kMaxHikeSummaries = 2000
+const uint16_t kLogRingStorageSize = Layout::kSummaryRing.size;
+const uint16_t kSDBlockSize = 512;
+const uint16_t kLogRingAddressesEEAddr = Layout::kSummaryRingHeader.start;
+const uint16_t kLogRingStorageEEAddr = Layout::kSummaryRing.start;
 
 time32_t HikeLog::sFileCreationTime;
 
@@ -76,6 +66,7 @@ bool HikeLog::Initialize(
 	mSDSelectPin = inSDSelectPin;
 	bool	success = true;
 	mHike.startTime = 0;
+	mCorruptLogs = 0;
 	
 	/*
 	*	Full is the position of the end of the stream minus the size of the
@@ -139,6 +130,14 @@ bool HikeLog::Initialize(
 			*/
 			if (header.startTime)
 			{
+				/*
+				*	A corrupt header is only counted.  Its entries still need
+				*	to be skipped to find the end of the logs.
+				*/
+				if (!HeaderIsValid(header))
+				{
+					mCorruptLogs++;
+				}
 				while (success)
 				{
 					// Read up to kNumEntriesPerPass entries at at time
@@ -286,6 +285,7 @@ bool HikeLog::StartLog(
 			HikeLocations::GetInstance().GoToLocation(mHike.endingLocIndex);
 			memcpy(&logHeader.end, &HikeLocations::GetInstance().GetCurrent().loc, sizeof(SHikeLocation));
 			LogTempPres::GetInstance().SetEndingAltitude(HikeLocations::GetInstance().GetCurrent().loc.elevation);
+			SetHeaderCRC(logHeader);
 			mStartDataPos = mLogData->GetPos();
 			success = mLogData->Write(sizeof(SHikeLogHeader), &logHeader) == sizeof(SHikeLogHeader) &&
 					LogEntry();	// Write the first entry and mark the end of the log
@@ -362,6 +362,90 @@ bool HikeLog::LogEntry(void)
 	return(success);
 }
 
+/******************************** ReadEntries *********************************/
+/*
+*	The active log's last entry is followed by the end of log nulls, so the
+*	entries can be read while the log is running.  To avoid reading the nulls
+*	each time there's nothing new, reading the active log stops at the
+*	current stream position (the first of the nulls.)
+*/
+uint8_t HikeLog::ReadEntries(
+	uint32_t&		ioPos,
+	SHikeLogEntry*	outEntries,
+	uint8_t			inMaxEntries)
+{
+	uint32_t	savedPos = mLogData->GetPos();
+	uint8_t	entriesRead = ReadEntriesTo(ioPos, outEntries, inMaxEntries,
+					(mHike.startTime && ioPos > mStartDataPos) ? savedPos : 0xFFFFFFFF);
+	mLogData->Seek(savedPos, DataStream::eSeekSet);
+	return(entriesRead);
+}
+
+/******************************* ReadEntriesTo ********************************/
+/*
+*	Reads entries from ioPos up to inEndPos, the entry with a null pressure
+*	that ends the log, or inMaxEntries, whichever comes first.  The log data
+*	stream position is left wherever the read left it.
+*/
+uint8_t HikeLog::ReadEntriesTo(
+	uint32_t&		ioPos,
+	SHikeLogEntry*	outEntries,
+	uint8_t			inMaxEntries,
+	uint32_t		inEndPos)
+{
+	uint8_t	entriesRead = 0;
+	if (ioPos < inEndPos)
+	{
+		if ((inEndPos - ioPos) < (uint32_t)inMaxEntries * sizeof(SHikeLogEntry))
+		{
+			inMaxEntries = (inEndPos - ioPos)/sizeof(SHikeLogEntry);
+		}
+		mLogData->Seek(ioPos, DataStream::eSeekSet);
+		uint8_t	entriesAvail = mLogData->Read(inMaxEntries*sizeof(SHikeLogEntry), outEntries)/sizeof(SHikeLogEntry);
+		for (; entriesRead < entriesAvail; entriesRead++)
+		{
+			if (outEntries[entriesRead].pressure == 0)
+			{
+				break;
+			}
+		}
+		ioPos += entriesRead * sizeof(SHikeLogEntry);
+	}
+	return(entriesRead);
+}
+
+/******************************* FindLogEntries *******************************/
+/*
+*	The logs are scanned from the start of the log data stream.  The header of
+*	the next log follows the 32 bit null that ends the previous log.
+*/
+uint32_t HikeLog::FindLogEntries(
+	time32_t	inStartTime)
+{
+	uint32_t	savedPos = mLogData->GetPos();
+	uint32_t	entriesPos = 0;
+	uint32_t	pos = 0;
+	SHikeLogHeader	header;
+	SHikeLogEntry	entry[kNumEntriesPerPass];
+	mLogData->Seek(0, DataStream::eSeekSet);
+	while (mLogData->Read(sizeof(SHikeLogHeader), &header) == sizeof(SHikeLogHeader) &&
+		header.startTime)
+	{
+		pos += sizeof(SHikeLogHeader);
+		if (header.startTime == inStartTime &&
+			HeaderIsValid(header))
+		{
+			entriesPos = pos;
+			break;
+		}
+		while (ReadEntriesTo(pos, entry, kNumEntriesPerPass, 0xFFFFFFFF) == kNumEntriesPerPass){}
+		pos += sizeof(uint32_t);
+		mLogData->Seek(pos, DataStream::eSeekSet);
+	}
+	mLogData->Seek(savedPos, DataStream::eSeekSet);
+	return(entriesPos);
+}
+
 /******************************* LogEntryIfTime *******************************/
 bool HikeLog::LogEntryIfTime(void)
 {
@@ -399,10 +483,10 @@ bool HikeLog::EndLog(void)
 	{
 		SRingHeader	header;
 		EEPROM.get(kLogRingAddressesEEAddr, header);
-		header.tail = (header.tail + sizeof(SHikeSummary)) % (sizeof(SHikeSummary)*kMaxHikeSummaries);
+		header.tail = (header.tail + sizeof(SHikeSummary)) % kLogRingStorageSize;
 		if (header.tail == header.head)
 		{
-			header.head = (header.head + sizeof(SHikeSummary)) % (sizeof(SHikeSummary)*kMaxHikeSummaries);
+			header.head = (header.head + sizeof(SHikeSummary)) % kLogRingStorageSize;
 		}
 		EEPROM.put(kLogRingAddressesEEAddr, header);
 		EEPROM.put(header.tail + kLogRingStorageEEAddr, mHike);
@@ -411,7 +495,24 @@ bool HikeLog::EndLog(void)
 	/*
 	*	Write the start and end time from the hike summary
 	*/
+#ifdef HIKE_LOG_CRC
+	/*
+	*	The CRC covers the entire header so the header is read back, updated
+	*	and rewritten with its new CRC.
+	*/
+	SHikeLogHeader	logHeader;
+	bool	success = mLogData->Read(sizeof(SHikeLogHeader), &logHeader) == sizeof(SHikeLogHeader);
+	if (success)
+	{
+		logHeader.startTime = mHike.startTime;
+		logHeader.endTime = mHike.endTime;
+		SetHeaderCRC(logHeader);
+		mLogData->Seek(mStartDataPos, DataStream::eSeekSet);
+		success = mLogData->Write(sizeof(SHikeLogHeader), &logHeader) == sizeof(SHikeLogHeader);
+	}
+#else
 	bool	success = mLogData->Write(8, &mHike.startTime) == 8;
+#endif
 	if (success)
 	{
 		/*
@@ -435,6 +536,26 @@ bool HikeLog::EndLog(void)
 	return(success);
 }
 
+/******************************** SetHeaderCRC ********************************/
+void HikeLog::SetHeaderCRC(
+	SHikeLogHeader&	ioHeader)
+{
+#ifdef HIKE_LOG_CRC
+	ioHeader.crc = CRC16::Calc(&ioHeader, offsetof(SHikeLogHeader, crc));
+#endif
+}
+
+/******************************* HeaderIsValid ********************************/
+bool HikeLog::HeaderIsValid(
+	const SHikeLogHeader&	inHeader)
+{
+#ifdef HIKE_LOG_CRC
+	return(CRC16::Calc(&inHeader, offsetof(SHikeLogHeader, crc)) == inHeader.crc);
+#else
+	return(true);
+#endif
+}
+
 /******************************* UInt32ToHexStr *******************************/
 /*
 *	Returns the pointer to the char after the last char (where you would place
@@ -467,6 +588,7 @@ bool HikeLog::SaveLogToSD(void)
 		mLogData->Seek(0, DataStream::eSeekSet);
 		SHikeLogEntry	entry[kNumEntriesPerPass];
 		SHikeLogHeader	header;
+		mCorruptLogs = 0;
 		sFileCreationTime = UnixTime::Time();
 		SdFile::dateTimeCallback(SDFatDateTimeCB);
 		while (success)
@@ -480,7 +602,21 @@ bool HikeLog::SaveLogToSD(void)
 			*/
 			if (header.startTime)
 			{
-				sFileCreationTime = header.startTime;
+				/*
+				*	A log with a corrupt header is still saved so that its
+				*	entries can be recovered, but it's saved with a .BAD
+				*	extension to mark it.  Its start time can't be trusted so
+				*	the current time is used for the file creation date.
+				*/
+				bool	headerIsValid = HeaderIsValid(header);
+				if (headerIsValid)
+				{
+					sFileCreationTime = header.startTime;
+				} else
+				{
+					sFileCreationTime = UnixTime::Time();
+					mCorruptLogs++;
+				}
 				/*
 				*	Create a file to hold this log.
 				*	The filename is based on the date and time.
@@ -490,7 +626,8 @@ bool HikeLog::SaveLogToSD(void)
 				SdFile file;
 				{
 					char filename[15];
-					strcpy_P(UInt32ToHexStr(header.startTime, filename), kFileExtStr);
+					strcpy_P(UInt32ToHexStr(header.startTime, filename),
+								headerIsValid ? kFileExtStr : kCorruptFileExtStr);
 					sd.remove(filename);
 					success = file.open(filename, O_WRONLY | O_CREAT);
 				}
@@ -562,6 +699,73 @@ bool HikeLog::SaveLogToSD(void)
 	return(success);
 }
 
+/******************************** StreamToFile ********************************/
+/*
+*	Copies the remainder of inStream to inFile.  The copy is done in chunks
+*	sized so that no write straddles an SD block boundary.  The buffer is
+*	kept small because SdFat already has a 512 byte block cache.
+*/
+static bool StreamToFile(
+	DataStream*	inStream,
+	SdFile&		inFile)
+{
+	uint8_t		buffer[128];	// Must be a divisor of kSDBlockSize
+	uint32_t	bytesLeft = inStream->Clip(0xFFFFFF);
+	bool		success = true;
+	while (success && bytesLeft)
+	{
+		uint16_t	bytes2Copy = kSDBlockSize - (inFile.curPosition() % kSDBlockSize);
+		if (bytes2Copy > sizeof(buffer))
+		{
+			bytes2Copy = sizeof(buffer);
+		}
+		if (bytes2Copy > bytesLeft)
+		{
+			bytes2Copy = bytesLeft;
+		}
+		success = inStream->Read(bytes2Copy, buffer) == bytes2Copy &&
+					inFile.write(buffer, bytes2Copy) == bytes2Copy;
+		bytesLeft -= bytes2Copy;
+	}
+	return(success);
+}
+
+/******************************** FileToStream ********************************/
+/*
+*	Copies from inFile to inStream till either the end of the file or the
+*	end of the stream is reached.  When inStream is a DataStream_E only the
+*	bytes that differ are written to the EEPROM.
+*/
+static bool FileToStream(
+	SdFile&		inFile,
+	DataStream*	inStream)
+{
+	uint8_t		buffer[128];	// Must be a divisor of kSDBlockSize
+	uint32_t	bytesLeft = inStream->Clip(0xFFFFFF);
+	bool		success = true;
+	while (success && bytesLeft)
+	{
+		uint16_t	bytes2Copy = kSDBlockSize - (inFile.curPosition() % kSDBlockSize);
+		if (bytes2Copy > sizeof(buffer))
+		{
+			bytes2Copy = sizeof(buffer);
+		}
+		if (bytes2Copy > bytesLeft)
+		{
+			bytes2Copy = bytesLeft;
+		}
+		int	bytesRead = inFile.read(buffer, bytes2Copy);
+		if (bytesRead <= 0)
+		{
+			success = bytesRead == 0;	// 0 = end of file
+			break;
+		}
+		success = inStream->Write(bytesRead, buffer) == (uint32_t)bytesRead;
+		bytesLeft -= bytesRead;
+	}
+	return(success);
+}
+
 /**************************** SaveLogSummariesToSD ****************************/
 bool HikeLog::SaveLogSummariesToSD(void)
 {
@@ -570,10 +774,6 @@ bool HikeLog::SaveLogSummariesToSD(void)
 	if (success)
 	{
 		SRingHeader		header;
-		struct SSummaryBlock
-		{
-			SHikeSummary	summary[5];	// Assumes kMaxHikeSummaries is 125, so 125/5 = 25, no remainder
-		} summaryBlock;
 		EEPROM.get(kLogRingAddressesEEAddr, header);
 		/*
 		*	[32]	uint16_t	lastHikesHead
@@ -598,15 +798,9 @@ bool HikeLog::SaveLogSummariesToSD(void)
 			}
 			if (success)
 			{
-				success = file.write(&header, sizeof(SRingHeader)) == sizeof(SRingHeader);
-				uint16_t	summaryStorageEEAddr = kLogRingStorageEEAddr;
-				for (; success &&
-						summaryStorageEEAddr < (kLogRingStorageEEAddr + (sizeof(SHikeSummary) * kMaxHikeSummaries));
-							summaryStorageEEAddr += sizeof(SSummaryBlock))
-				{
-					EEPROM.get(summaryStorageEEAddr, summaryBlock);
-					success = file.write(&summaryBlock, sizeof(SSummaryBlock)) == sizeof(SSummaryBlock);
-				}
+				DataStream_E	summaries((const void*)kLogRingStorageEEAddr, kLogRingStorageSize);
+				success = file.write(&header, sizeof(SRingHeader)) == sizeof(SRingHeader) &&
+							StreamToFile(&summaries, file);
 				file.close();
 				Serial.println(success ? F("Success!") : F("Write Error"));
 			} else
@@ -632,10 +826,6 @@ bool HikeLog::LoadLogSummariesFromSD(void)
 	if (success)
 	{
 		SRingHeader		header;
-		struct SSummaryBlock
-		{
-			SHikeSummary	summary[5];	// Assumes kMaxHikeSummaries is 125, so 125/5 = 25, no remainder
-		} summaryBlock;
 		/*
 		*	Open the summaries file.
 		*/
@@ -647,20 +837,27 @@ bool HikeLog::LoadLogSummariesFromSD(void)
 		}
 		if (success)
 		{
-			success = file.read(&header, sizeof(SRingHeader)) == sizeof(SRingHeader);
+			/*
+			*	The summaries are only loaded if the file is the size of the
+			*	current ring, and the ring indexes are within the ring and on
+			*	a summary boundary.  Anything else is either corrupt or was
+			*	saved with a different ring size or summary layout.  The
+			*	EEPROM ring header is only updated after the ring is loaded.
+			*/
+			success = file.fileSize() == (sizeof(SRingHeader) + kLogRingStorageSize) &&
+						file.read(&header, sizeof(SRingHeader)) == sizeof(SRingHeader) &&
+						header.head < kLogRingStorageSize &&
+						header.tail < kLogRingStorageSize &&
+						(header.head % sizeof(SHikeSummary)) == 0 &&
+						(header.tail % sizeof(SHikeSummary)) == 0;
 			if (success)
 			{
-				EEPROM.put(kLogRingAddressesEEAddr, header);
 				Serial.println(F("Loading "));
-
-				uint16_t	summaryStorageEEAddr = kLogRingStorageEEAddr;
-				for (; success &&
-						summaryStorageEEAddr < (kLogRingStorageEEAddr + (sizeof(SHikeSummary) * kMaxHikeSummaries));
-							summaryStorageEEAddr += sizeof(SSummaryBlock))
+				DataStream_E	summaries((const void*)kLogRingStorageEEAddr, kLogRingStorageSize);
+				success = FileToStream(file, &summaries);
+				if (success)
 				{
-					success = file.read(&summaryBlock, sizeof(SSummaryBlock)) == sizeof(SSummaryBlock);
-					EEPROM.put(summaryStorageEEAddr, summaryBlock);
-					Serial.print('.');
+					EEPROM.put(kLogRingAddressesEEAddr, header);
 				}
 			}
 			file.close();
@@ -730,7 +927,7 @@ bool HikeLog::GetSavedHike(
 uint16_t HikeLog::GetNextSavedHikeRef(
 	uint16_t	inRef)
 {
-	uint16_t	ref = (inRef + sizeof(SHikeSummary)) % (sizeof(SHikeSummary)*kMaxHikeSummaries);
+	uint16_t	ref = (inRef + sizeof(SHikeSummary)) % kLogRingStorageSize;
 	SRingHeader	header;
 	EEPROM.get(kLogRingAddressesEEAddr, header);
 	/*
@@ -749,7 +946,7 @@ uint16_t HikeLog::GetNextSavedHikeRef(
 uint16_t HikeLog::GetPrevSavedHikeRef(
 	uint16_t	inRef)
 {
-	uint16_t	ref = (inRef + (sizeof(SHikeSummary)*(kMaxHikeSummaries-1))) % (sizeof(SHikeSummary)*kMaxHikeSummaries);
+	uint16_t	ref = (inRef + (sizeof(SHikeSummary)*(kMaxHikeSummaries-1))) % kLogRingStorageSize;
 	SRingHeader	header;
 	EEPROM.get(kLogRingAddressesEEAddr, header);
 	/*
@@ -53,7 +53,12 @@ class DataStream;
 *		zero pressure marks end of log.  When active the data stream points to
 *		this entry
 *		
+*	When HIKE_LOG_CRC is defined the header ends with a CRC16 of the preceding
+*	header fields.  The CRC is rewritten along with the header when the log
+*	ends.  A header with a bad CRC is the result of an interrupted write
+*	(e.g. a brownout.)  The entries aren't CRC protected.
 */
+//#define HIKE_LOG_CRC	1
 struct SHikeLogHeader
 {
 	time32_t		startTime;	// Unix time/date
@@ -61,6 +66,9 @@ struct SHikeLogHeader
 	time32_t		interval;
 	SHikeLocation	start;
 	SHikeLocation	end;
+#ifdef HIKE_LOG_CRC
+	uint16_t		crc;
+#endif
 };
 
 #pragma pack(push,1)
@@ -155,9 +163,45 @@ public:
 								uint16_t				inRef);
 	uint16_t				GetPrevSavedHikeRef(
 								uint16_t				inRef);
+							/*
+							*	The stream position of the active log's first
+							*	entry, or 0 if there is no active log.
+							*/
+	uint32_t				ActiveLogEntriesPos(void) const
+								{return(mHike.startTime ? (mStartDataPos + sizeof(SHikeLogHeader)) : 0);}
+							/*
+							*	Returns the stream position of the first entry
+							*	of the log that started at inStartTime, or 0 if
+							*	the log isn't in the log data stream.
+							*/
+	uint32_t				FindLogEntries(
+								time32_t				inStartTime);
+							/*
+							*	Reads up to inMaxEntries entries starting at
+							*	ioPos.  Reading stops at the end of the log.
+							*	ioPos is advanced past the entries read, and
+							*	the number of entries read is returned.  The
+							*	log data stream position isn't changed.
+							*/
+	uint8_t					ReadEntries(
+								uint32_t&				ioPos,
+								SHikeLogEntry*			outEntries,
+								uint8_t					inMaxEntries);
 	static char*			UInt32ToHexStr(
 								uint32_t				inNum,
 								char*					inBuffer);
+							/*
+							*	The number of log headers that failed the CRC
+							*	check during the last Initialize or SaveLogToSD
+							*	scan.  SaveLogToSD saves these logs with a .BAD
+							*	extension, and FindLogEntries skips them.
+							*/
+	uint8_t					CorruptLogs(void) const
+								{return(mCorruptLogs);}
+	static void				SetHeaderCRC(
+								SHikeLogHeader&			ioHeader);
+	static bool				HeaderIsValid(
+								const SHikeLogHeader&	inHeader);
 protected:
 	DataStream*			mLogData;
 	time32_t			mNextLogTime;
@@ -165,12 +209,18 @@ protected:
 	uint32_t			mStartDataPos;
 	uint32_t			mFullDataPos;
 	uint8_t				mSDSelectPin;
+	uint8_t				mCorruptLogs;
 	static time32_t		sFileCreationTime;
 	
 							/*
 							*	Used by SaveLogToSD to set the file creation
 							*	date and time.
 							*/
+	uint8_t					ReadEntriesTo(
+								uint32_t&				ioPos,
+								SHikeLogEntry*			outEntries,
+								uint8_t					inMaxEntries,
+								uint32_t				inEndPos);
 	static void				SDFatDateTimeCB(
 								uint16_t*				outDate,
 								uint16_t*				outTime);
@@ -23,10 +23,35 @@
 #define HikingLoggerConfig_h
 
 #include <inttypes.h>
+#include "StorageLayout.h"
 
 #define BAUD_RATE	19200
 #define LOGGER_VER	12	// v1.2
 #define USE_EXTERNAL_RTC
+/*
+*	The XFont SRAM opt-ins.  All three are off by default and are set up in
+*	setup() of HikingLoggerGateway.ino.
+*
+*	GLYPH_CACHE_SIZE is the SRAM budget in bytes for caching the normal font's
+*	digit glyphs (see XFontGlyphCache.h.)  The clock, temperature and
+*	altitude characters of MyriadPro-Regular_36_1b need about 600 bytes.
+*	Comment out to disable the cache.
+*/
+//#define GLYPH_CACHE_SIZE	600
+/*
+*	XFONT_GLYPH_HEADER_CACHE_SIZE is the number of glyph headers cached per
+*	font (see XFont::Font::SetGlyphHeaderCache.)  Each entry uses 9 bytes of
+*	SRAM, 216 bytes for the two fonts at 12 entries.  Comment out to disable
+*	the cache.
+*/
+//#define XFONT_GLYPH_HEADER_CACHE_SIZE	12
+/*
+*	When XFONT_ASCII_INDEX is defined each font has a table of the glyph entry
+*	indexes of the ASCII characters (see XFont::Font::SetASCIIIndex.)  The
+*	table uses 101 bytes of SRAM per font, 202 bytes for the two fonts.
+*	Comment out to disable the index.
+*/
+//#define XFONT_ASCII_INDEX
 
 /*
 *	IMPORTANT RADIO SETTINGS
@@ -87,32 +112,11 @@ namespace Config
 	const uint8_t	kPINCBtnMask = (_BV(PINC4) | _BV(PINC5));
 	const uint8_t	kPINDBtnMask = (_BV(PIND5) | _BV(PIND6) | _BV(PIND7));
 
-	/*
-	*	EEPROM usage, 2K bytes (assumes ATmega644PA)
-	*
-	*	[0]		uint8_t		networkID;
-	*	[1]		uint8_t		nodeID;
-	*	[2]		uint8_t		unassigned[2];
-	*
-	*	Rest used by HikeLog
-	*	[4]		uint16_t	lastStartingLocIndex;
-	*	[6]		uint16_t	lastEndingLocIndex;
-	*	[8]		uint8_t		logInitialized;
-	*	[9]		uint8_t		unassigned2[23];
-	*
-	*	Storage of the last n hikes, circular storage, 16 byte struct
-	*	[32]	uint16_t	lastHikesHead
-	*	[34]	uint16_t	lastHikesTail
-	*	[36]	uint8_t		unassigned3[2];
-	*	[38]	SHikeSummary hikes[125];
-	*	[2038]	uint8_t		unassigned4[10];
-	*/
-
-	const uint16_t	kFlagsAddr			= 0;
+	// See StorageLayout.h for the MCU's EEPROM usage.
+	const uint16_t	kFlagsAddr			= Layout::kFlags.start;
 	const uint8_t	k12HourClockBit		= 0;
 	const uint8_t	kEnableSleepBit		= 1;
 	const uint8_t	kOnlyUseISPBit		= 2;
-	const uint16_t	kISP_SPIClockAddr	= 1;
 
 
 	const uint8_t	kTextInset			= 3; // Makes room for drawing the selection frame
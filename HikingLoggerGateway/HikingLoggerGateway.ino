@@ -38,6 +38,10 @@
 #include "AT24CDataStream.h"
 #include "AT24C.h"
 #include "HikingLoggerConfig.h"
+#include "StorageLayout.h"
+#ifdef GLYPH_CACHE_SIZE
+#include "XFontGlyphCache.h"
+#endif
 
 #ifdef USE_EXTERNAL_RTC
 #include "DS3231SN.h"
@@ -45,13 +49,9 @@
 #include "CompileTime.h"
 #endif
 
-const uint8_t kAT24CDeviceAddr = 0x50;		// Serial EEPROM
-const uint8_t kAT24CDeviceCapacity = 32;	// Value at end of AT24Cxxx xxx/8
-AT24C	at24C(kAT24CDeviceAddr, kAT24CDeviceCapacity);
-const uint32_t	kHikeLocationsSize = 0x400; // 38 maximum (39 -1, -1 for the root)
-const uint32_t	kHikeLogSize = ((uint32_t)kAT24CDeviceCapacity * 1024) - kHikeLocationsSize;	// Rest of space for logs
-AT24CDataStream locationsDataStream(&at24C, 0, kHikeLocationsSize);
-AT24CDataStream logDataStream(&at24C, (const void*)kHikeLocationsSize, kHikeLogSize);
+AT24C	at24C(Layout::kAT24CDeviceAddr, Layout::kAT24CCapacity);
+AT24CDataStream locationsDataStream(&at24C, (const void*)Layout::kHikeLocations.start, Layout::kHikeLocations.size);
+AT24CDataStream logDataStream(&at24C, (const void*)Layout::kHikeLog.start, Layout::kHikeLog.size);
 
 TFT_ST7789	display(Config::kDCPin, Config::kResetPin, Config::kCDPin, Config::kBacklightPin, 240, 240);
 LogUI		logUI;
@@ -63,6 +63,11 @@ LogUI		logUI;
 
 HikeLog		hikeLog;
 
+#ifdef GLYPH_CACHE_SIZE
+uint8_t			glyphCacheBuffer[GLYPH_CACHE_SIZE];
+XFontGlyphCache	glyphCache(glyphCacheBuffer, GLYPH_CACHE_SIZE);
+#endif
+
 #ifdef USE_EXTERNAL_RTC
 DS3231SN	externalRTC;
 #endif
@@ -99,13 +104,58 @@ void setup(void)
 	*	The location names and elevations are stored on EEPROM.
 	*	Calling begin initialized the hikeLocations instance by counting the
 	*	number of locations on the associated stream.
+	*	Any older EEPROM layout is migrated before either is initialized.
 	*/
+	bool	layoutIsCurrent = Layout::Migrate(&locationsDataStream);
 	HikeLocations::GetInstance().Initialize(&locationsDataStream, Config::kSDSelectPin);
 	hikeLog.Initialize(&logDataStream, Config::kSDSelectPin);
 
 	UnixTime::ResetSleepTime();
+#ifdef XFONT_GLYPH_HEADER_CACHE_SIZE
+	{
+		static XFont::GlyphHeaderCacheEntry	sNormalHeaderCache[XFONT_GLYPH_HEADER_CACHE_SIZE];
+		static XFont::GlyphHeaderCacheEntry	sSmallHeaderCache[XFONT_GLYPH_HEADER_CACHE_SIZE];
+		MyriadPro_Regular_36_1b::font.SetGlyphHeaderCache(sNormalHeaderCache, XFONT_GLYPH_HEADER_CACHE_SIZE);
+		MyriadPro_Regular_18::font.SetGlyphHeaderCache(sSmallHeaderCache, XFONT_GLYPH_HEADER_CACHE_SIZE);
+	}
+#endif
+#ifdef XFONT_ASCII_INDEX
+	{
+		static XFont::ASCIIIndex	sNormalASCIIIndex;
+		static XFont::ASCIIIndex	sSmallASCIIIndex;
+		MyriadPro_Regular_36_1b::font.SetASCIIIndex(&sNormalASCIIIndex);
+		MyriadPro_Regular_18::font.SetASCIIIndex(&sSmallASCIIIndex);
+	}
+#endif
 	logUI.begin(&hikeLog, &display, &MyriadPro_Regular_36_1b::font,
 												&MyriadPro_Regular_18::font);
+	/*
+	*	Draw each string as one or a few windows rather than 4 or more per
+	*	glyph (see XFont::SetSingleWindowMode.)
+	*/
+	logUI.SetSingleWindowMode(true);
+#ifdef GLYPH_CACHE_SIZE
+	/*
+	*	begin made the normal font current.  Cache the characters of the
+	*	clock, temperature and altitude.
+	*/
+	glyphCache.Load(&logUI, "0123456789:'°");
+	logUI.SetGlyphCache(&glyphCache);
+#endif
+	/*
+	*	Initialize counted any log headers that failed their CRC check.
+	*	The location records are checked in one pass here.
+	*/
+	logUI.SetCorruptRecords(HikeLocations::GetInstance().Verify() + hikeLog.CorruptLogs());
+	/*
+	*	If the layout is unknown (e.g. written by newer firmware) or couldn't
+	*	be migrated THEN
+	*	logging is disabled till the user resets the log from the log mode.
+	*/
+	if (!layoutIsCurrent)
+	{
+		logUI.SetLayoutError();
+	}
 }
 
 /************************************ loop ************************************/
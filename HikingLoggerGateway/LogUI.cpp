@@ -40,6 +40,7 @@
 #include "UnixTime.h"
 #include "BMP280Utils.h"
 #include "HikingLoggerConfig.h"
+#include "StorageLayout.h"
 
 const char kStartStr[] PROGMEM = "START";
 const char kResumeStr[] PROGMEM = "RESUME";
@@ -60,6 +61,10 @@ const char kBMP280PressEnterToSyncStr[] PROGMEM = "[ENTER] 2 SYNC";
 const char kBMP280SyncStr[] PROGMEM = "SYNCING BMP";
 const char kBMP280SyncSuccessStr[] PROGMEM = "BMP SYNCD";
 
+const char kBadCRCStr[] PROGMEM = " BAD CRC";
+const char kLayoutErrorStr[] PROGMEM = "LAYOUT ERROR";
+const char kPressEnterToResetStr[] PROGMEM = "ENTER: RESET";
+
 const char kSetTimeStr[] PROGMEM = "SET TIME";
 const char kTestMP3Str[] PROGMEM = "TEST MP3";
 
@@ -120,7 +125,8 @@ bool	LogUI::sSDInsertedOrRemoved;
 LogUI::LogUI(void)
 : mSDCardPresent(false), mRadio(Config::kRadioNSSPin, Config::kRadioIRQPin),
 	mMP3Player(Serial1, Config::kMP3RxPin, Config::kMP3TxPin, Config::kMP3PowerPin),
-	mDebouncePeriod(DEBOUNCE_DELAY), mWasSyncd(false)
+	mDebouncePeriod(DEBOUNCE_DELAY), mWasSyncd(false), mLayoutError(false),
+	mCorruptRecords(0)
 {
 	pinMode(Config::kSDDetectPin, INPUT_PULLUP);
 	pinMode(Config::kSDSelectPin, OUTPUT);
@@ -171,8 +177,8 @@ LogUI::LogUI(void)
 
 	// Read the network and node IDs from EEPROM
 	{
-		uint8_t	networkID = EEPROM.read(0);
-		uint8_t	nodeID = EEPROM.read(1);
+		uint8_t	networkID = EEPROM.read(Layout::kNetworkID.start);
+		uint8_t	nodeID = EEPROM.read(Layout::kNodeID.start);
 		mRadio.initialize(FREQUENCY, nodeID, networkID);
 		mRadio.sleep();
 		/*
@@ -211,6 +217,7 @@ void LogUI::begin(
 	mNormalFont = inNormalFont;
 	mSmallFont = inSmallFont;
 	mUnixTimeEditor.Initialize(this);
+	mAltitudeProfile.Initialize(inHikeLog, inDisplay);
 }
 
 /******************************** GoToLogMode *********************************/
@@ -234,14 +241,14 @@ void LogUI::UpDownButtonPressed(
 	//	No sync error: eLogMode <> eStartLocSelMode <> eEndLocSelMode <> eReviewHikesMode <> eLogMode
 	//	Sync error: eLogMode <> eBMP280SyncMode <> eStartLocSelMode <> eEndLocSelMode <> eReviewHikesMode <> eLogMode
 	// Active hike
-	//	No sync error: eLogMode <> eReviewHikesMode <> eLogMode
-	//	Sync error: eLogMode <> eBMP280SyncMode <> eReviewHikesMode <> eLogMode
+	//	No sync error: eLogMode <> eAltitudeProfileMode <> eReviewHikesMode <> eLogMode
+	//	Sync error: eLogMode <> eAltitudeProfileMode <> eBMP280SyncMode <> eReviewHikesMode <> eLogMode
 	switch (mode)
 	{
 		case eLogMode:
 			if (mHikeLog->Active())
 			{
-				mode = inIncrement ? (mSyncState != eBMP280SyncError ? eReviewHikesMode : eBMP280SyncMode) : eReviewHikesMode;
+				mode = inIncrement ? eAltitudeProfileMode : eReviewHikesMode;
 			} else
 			{
 				mode = inIncrement ? (mSyncState != eBMP280SyncError ? eStartLocSelMode : eBMP280SyncMode) : eReviewHikesMode;
@@ -253,10 +260,13 @@ void LogUI::UpDownButtonPressed(
 		case eEndLocSelMode:
 			mode = inIncrement ? eTestMP3Mode : eStartLocSelMode;
 			break;
+		case eAltitudeProfileMode:
+			mode = inIncrement ? (mSyncState != eBMP280SyncError ? eReviewHikesMode : eBMP280SyncMode) : eLogMode;
+			break;
 		case eReviewHikesMode:
 			if (mHikeLog->Active())
 			{
-				mode = inIncrement ? eLogMode : (mSyncState != eBMP280SyncError ? eLogMode : eBMP280SyncMode);
+				mode = inIncrement ? eLogMode : (mSyncState != eBMP280SyncError ? eAltitudeProfileMode : eBMP280SyncMode);
 			} else
 			{
 				mode = inIncrement ? eLogMode : eSetTimeMode;
@@ -274,7 +284,7 @@ void LogUI::UpDownButtonPressed(
 			{
 				if (mHikeLog->Active())
 				{
-					mode = inIncrement ? eLogMode : eReviewHikesMode;
+					mode = inIncrement ? eReviewHikesMode : eAltitudeProfileMode;
 				} else
 				{
 					mode = inIncrement ? eStartLocSelMode : eLogMode;
@@ -327,6 +337,16 @@ void LogUI::EnterPressed(void)
 	switch (mMode)
 	{
 		case eLogMode:
+			/*
+			*	If the stored layout couldn't be migrated THEN
+			*	the only option is to reset the log.
+			*/
+			if (mLayoutError)
+			{
+				mMode = eResetLogMode;
+				mResetLogState = eResetVerifyNo;
+				break;
+			}
 			switch(mHikeLog->GetLogState() + mLogStateModifier)
 			{
 				case HikeLog::eStopped + HikeLog::eModifier:
@@ -367,11 +387,20 @@ void LogUI::EnterPressed(void)
 		case eResetLogMode:
 			if (mResetLogState == eResetVerifyYes)
 			{
+				if (mLayoutError)
+				{
+					Layout::Reset();
+				}
 				mResetLogState = mHikeLog->InitializeLog() ? eResetSuccess : eResetError;
+				mLayoutError = mLayoutError && mResetLogState == eResetError;
 			}
 			break;
 		case eReviewHikesMode:
-			mReviewState = !mReviewState;
+			mReviewState++;
+			if (mReviewState >= eNumReviewStates)
+			{
+				mReviewState = eReviewLocs;
+			}
 			break;
 		case eBMP280SyncMode:
 			switch (mSyncState)
@@ -465,7 +494,13 @@ void LogUI::Update(void)
 
 	if (!mSleeping)
 	{
+		/*
+		*	Erased lines are deferred till the end of the frame so that only
+		*	what isn't redrawn is erased.
+		*/
+		mDisplay->BeginFrame();
 		UpdateDisplay();
+		mDisplay->EndFrame();
 		/*
 		*	Some action states need to be reflected in the display before
 		*	performing an action.
@@ -477,10 +512,23 @@ void LogUI::Update(void)
 				{
 					case eSavingToSD:
 					{
-						mSDCardState = ((mSDCardAction == eSaveHikeLogUI) ?
-										mHikeLog->SaveLogToSD() : 
-											HikeLocations::GetInstance().SaveToSD()) ?
-												eSDSavedSuccess : eSDError;
+						/*
+						*	The corrupt record count shown is that of what was
+						*	saved.  The log headers are verified by SaveLogToSD
+						*	as they're saved.  The locations are verified
+						*	before they're saved.
+						*/
+						bool	saved;
+						if (mSDCardAction == eSaveHikeLogUI)
+						{
+							saved = mHikeLog->SaveLogToSD();
+							mCorruptRecords = mHikeLog->CorruptLogs();
+						} else
+						{
+							mCorruptRecords = HikeLocations::GetInstance().Verify();
+							saved = HikeLocations::GetInstance().SaveToSD();
+						}
+						mSDCardState = saved ? eSDSavedSuccess : eSDError;
 						break;
 					}
 					case eUpdatingFromSD:
@@ -524,7 +572,7 @@ void LogUI::Update(void)
 				case '.':	// Dump the summaries ring buffer head and tail
 				{
 					SRingHeader	header;
-					EEPROM.get(32, header);
+					EEPROM.get(Layout::kSummaryRingHeader.start, header);
 					Serial.print(F("head = 0x"));
 					Serial.print(header.head, HEX);
 					Serial.print(F(", tail = 0x"));
@@ -565,13 +613,13 @@ void LogUI::Update(void)
 					SRingHeader	header;
 					header.head = 0;
 					header.tail = 0;
-					EEPROM.put(32, header);
+					EEPROM.put(Layout::kSummaryRingHeader.start, header);
 					break;
 				}
 			#if 0
 				case 'd':	// Dump the logs currently on the serial eeprom
 				{
-					AT24CDataStream dumpStream(&at24C, (const void*)kHikeLocationsSize, kHikeLogSize);
+					AT24CDataStream dumpStream(&at24C, (const void*)Layout::kHikeLog.start, Layout::kHikeLog.size);
 					dumpStream.Seek(0, DataStream::eSeekSet);
 					SHikeLogHeader	header;
 					while(true)
@@ -1258,8 +1306,9 @@ void LogUI::HandlePacketRx(void)
 		case Log::kStartLog:	// Start or resume the log
 		{
 			uint8_t	logState = mHikeLog->GetLogState();
-			if (logState == HikeLog::eStopped ||
-				logState == HikeLog::eNotRunning)
+			if (!mLayoutError &&
+				(logState == HikeLog::eStopped ||
+				logState == HikeLog::eNotRunning))
 			{
 				mMode = eLogMode;
 				mLogStateModifier = HikeLog::eModifier;
@@ -1409,13 +1458,30 @@ void LogUI::DrawTextOption(
 	}
 }
 
+/***************************** DrawCorruptRecords *****************************/
+/*
+*	Draws the number of records that failed their CRC check, if any.
+*/
+void LogUI::DrawCorruptRecords(
+	uint8_t	inLine)
+{
+	if (mCorruptRecords)
+	{
+		char countStr[32];
+		strcpy_P(&countStr[BMP280Utils::Int32ToIntStr((int32_t)mCorruptRecords*100, countStr)], kBadCRCStr);
+		MoveTo(inLine);
+		SetTextColor(eYellow);
+		DrawCentered(countStr);
+	}
+}
+
 /********************************* ClearLines *********************************/
 void LogUI::ClearLines(
 	uint8_t	inStartLine,
 	uint8_t	inNumLines)
 {
 	MoveTo(inStartLine,0);
-	mDisplay->FillBlock(43*inNumLines, 240, eBlack);
+	mDisplay->EraseBlock(43*inNumLines, 240);
 }
 
 /******************************* UpdateDisplay ********************************/
@@ -1437,12 +1503,23 @@ void LogUI::UpdateDisplay(void)
 	if (mMode != eReviewHikesMode &&
 		mMode != eEditTimeMode)
 	{
+		/*
+		*	Only the changed glyphs of the time and altitude are drawn unless
+		*	their fields were erased or may have been drawn over by the
+		*	previous mode.
+		*/
+		if (updateAll ||
+			mMode != mPrevMode)
+		{
+			mTimeField.Invalidate();
+			mAltitudeField.Invalidate();
+		}
 		if (updateAll)
 		{
 			if (mPrevMode == eReviewHikesMode)
 			{
 				MoveTo(3);
-				mDisplay->FillBlock(25, 240, eBlack);
+				mDisplay->EraseBlock(25, 240);
 			}
 			/*
 			*	Draw a 2 pixel horizontal line halfway between line 3 relative to
@@ -1453,7 +1530,7 @@ void LogUI::UpdateDisplay(void)
 			mDisplay->FillBlock(2, 240, eGray);
 			// Move to line 4 relative to the display bottom.
 			mDisplay->MoveTo(240-(43*2), 0);
-			mDisplay->FillBlock(43*2, 240, eBlack);
+			mDisplay->EraseBlock(43*2, 240);
 		}
 	
 		if (updateAll ||
@@ -1465,7 +1542,9 @@ void LogUI::UpdateDisplay(void)
 			bool isPM = UnixTime::CreateTimeStr(timeStr);
 			mDisplay->MoveTo(240-(43*2), 45);	// Line 4 relative to the display bottom
 			SetTextColor(eWhite);
+			SetTextField(&mTimeField);
 			DrawStr(timeStr);
+			SetTextField(nullptr);
 			uint8_t showingAMPM = UnixTime::Format24Hour() ? 0 : (isPM ? 1 : 2);
 			/*
 			*	If updating everything OR
@@ -1526,7 +1605,9 @@ void LogUI::UpdateDisplay(void)
 			LogTempPres::GetInstance().CreateAltitudeStr(altitude, altitudeStr);
 			mDisplay->MoveTo(240-43, 0);	// Line 5 relative to the display bottom
 			SetTextColor(eYellow);
+			SetTextField(&mAltitudeField);
 			DrawRightJustified(altitudeStr);
+			SetTextField(nullptr);
 		}
 	}
 	updateAll = updateAll || mMode != mPrevMode;
@@ -1548,6 +1629,18 @@ void LogUI::UpdateDisplay(void)
 		*/
 		case eLogMode:
 		{
+			if (mLayoutError)
+			{
+				if (updateAll)
+				{
+					ClearLines();
+					MoveTo(0);
+					DrawTextOption(kLayoutErrorStr, eRed, false, true);
+					MoveTo(2);
+					DrawTextOption(kPressEnterToResetStr, eWhite, false, true);
+				}
+				break;
+			}
 			uint8_t	logState = mHikeLog->GetLogState() + mLogStateModifier;
 			if (updateAll ||
 				logState != mPrevLogState)
@@ -1660,6 +1753,18 @@ void LogUI::UpdateDisplay(void)
 			}
 			break;
 		}
+		/*
+		*	The profile of the active hike is drawn in place of the first 3
+		*	lines.  After the first update only the new log entries are read.
+		*/
+		case eAltitudeProfileMode:
+			if (updateAll)
+			{
+				ClearLines();
+				mAltitudeProfile.Start(mHikeLog->ActiveLogEntriesPos(), 0, 43*3);
+			}
+			mAltitudeProfile.Update();
+			break;
 		case eBMP280SyncMode:
 		{
 			if (updateAll ||
@@ -1669,6 +1774,7 @@ void LogUI::UpdateDisplay(void)
 				MoveTo(0);
 				mPrevSyncState = mSyncState;
 				DrawIndexedDescStr(kSyncStateDesc, mSyncState, false, true);
+				DrawCorruptRecords(1);
 				MoveTo(2);
 				if (mSyncState == eBMP280SyncError)
 				{
@@ -1714,6 +1820,10 @@ void LogUI::UpdateDisplay(void)
 				{
 					MoveTo(1);
 					DrawIndexedDescStr(kSDCardStateDesc, mSDCardState, false, true);
+					if (mSDCardState == eSDSavedSuccess)
+					{
+						DrawCorruptRecords(2);
+					}
 				}
 			}
 			break;
@@ -1726,7 +1836,8 @@ void LogUI::UpdateDisplay(void)
 			
 			if (updateAll)
 			{
-				mDisplay->Fill();
+				mDisplay->MoveTo(0, 0);
+				mDisplay->EraseBlock(240, 240);
 				mPrevHikeRef = mHikeRef;
 				if (hasSavedHikes)
 				{
@@ -1748,7 +1859,7 @@ void LogUI::UpdateDisplay(void)
 			} else if (mPrevReviewState != mReviewState)
 			{
 				MoveTo(1);
-				mDisplay->FillBlock(240-43, 240, eBlack);
+				mDisplay->EraseBlock(240-43, 240);
 				updateAll = true;
 			}
 			mPrevReviewState = mReviewState;
@@ -1773,10 +1884,11 @@ void LogUI::UpdateDisplay(void)
 					SetTextColor(eMagenta);
 					DrawRightJustified(tempStr);
 				/*
-				*	Else draw the elevation gain, and the start, end, and
-				*	elapsed time.  The day of week is placed on the bottom line.
+				*	Else if reviewing the data, draw the elevation gain, and
+				*	the start, end, and elapsed time.  The day of week is
+				*	placed on the bottom line.
 				*/
-				} else
+				} else if (mReviewState == eReviewData)
 				{
 					HikeLocations::GetInstance().GoToLocation(hikeSummary.endingLocIndex);
 					int32_t	elevation = HikeLocations::GetInstance().GetCurrent().loc.elevation;
@@ -1800,7 +1912,33 @@ void LogUI::UpdateDisplay(void)
 					MoveTo(4);
 					SetTextColor(eYellow);
 					DrawTime(hikeSummary.endTime - hikeSummary.startTime, false);
+				/*
+				*	Else draw the altitude profile below the date.  The log
+				*	may have been reset after it was saved to SD.
+				*/
+				} else
+				{
+					uint32_t	entriesPos = mHikeLog->FindLogEntries(hikeSummary.startTime);
+					if (entriesPos)
+					{
+						mAltitudeProfile.Start(entriesPos, 43, 240-43);
+						mAltitudeProfile.Update();
+					} else
+					{
+						// Stop reading the previously reviewed hike, if any.
+						mAltitudeProfile.Start(0, 43, 240-43);
+						MoveTo(2);
+						DrawTextOption(kNoneFoundStr, eYellow, false, true);
+					}
 				}
+			/*
+			*	The entries of a long hike are read over several updates.
+			*/
+			} else if (hasSavedHikes &&
+				mReviewState == eReviewProfile &&
+				mAltitudeProfile.HasBacklog())
+			{
+				mAltitudeProfile.Update();
 			}
 			break;
 		}
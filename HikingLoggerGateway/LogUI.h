@@ -30,6 +30,7 @@
 #include "UnixTimeEditor.h"
 #include "RFM69.h"    // https://github.com/LowPowerLab/RFM69
 #include "XFont.h"
+#include "AltitudeProfile.h"
 
 typedef uint32_t time32_t;
 class HikeLog;
@@ -49,6 +50,7 @@ public:
 		eResetLogMode,			// + EResetLogState
 		eStartLocSelMode,
 		eEndLocSelMode,
+		eAltitudeProfileMode,
 		eReviewHikesMode,
 		eSetTimeMode,
 		eEditTimeMode,
@@ -95,7 +97,9 @@ public:
 	enum EReviewState
 	{
 		eReviewLocs,
-		eReviewData
+		eReviewData,
+		eReviewProfile,
+		eNumReviewStates
 	};
 
 	void					begin(
@@ -106,6 +110,21 @@ public:
 	void					SetSDCardPresent(
 								bool					inSDCardPresent);
 	void					SetSDWriteSuccessAction(void);
+							/*
+							*	Called at boot when the stored layout couldn't
+							*	be migrated.  Logging isn't allowed till the
+							*	log is reset.
+							*/
+	void					SetLayoutError(void)
+								{mLayoutError = true;}
+							/*
+							*	The number of location records and log headers
+							*	that failed their CRC check.  Shown on the BMP280
+							*	sync (boot) screen and after saving to SD.
+							*/
+	void					SetCorruptRecords(
+								uint16_t				inCorruptRecords)
+								{mCorruptRecords = inCorruptRecords;}
 	
 	void					CheckRadioForPackets(
 								bool					inDisplayIsOff);
@@ -150,11 +169,15 @@ protected:
 	HikeLog*	mHikeLog;
 	Font*		mNormalFont;
 	Font*		mSmallFont;
+	TextField	mTimeField;
+	TextField	mAltitudeField;
+	AltitudeProfile	mAltitudeProfile;
 	MSPeriod	mDebouncePeriod;	// For buttons and SD card
 	MSPeriod	mBMP280Period;
 	MSPeriod	m3ButtonRemotePeriod;
 	uint16_t	mLocIndex;	// for eStartLocSelMode and eEndLocSelMode
 	uint16_t	mHikeRef;
+	uint16_t	mCorruptRecords;
 	uint8_t		mMode;
 	uint8_t		mSyncState;
 	uint8_t		mSDCardState;
@@ -166,6 +189,7 @@ protected:
 	bool		mSDCardPresent;
 	bool		mSleeping;
 	bool		mWasSyncd;
+	bool		mLayoutError;
 
 	uint8_t		mPrevLogState;
 	uint8_t		mPrevMode;
@@ -212,6 +236,8 @@ protected:
 								uint16_t				inColor,
 								bool					inHasOptions,
 								bool					inCentered);
+	void					DrawCorruptRecords(
+								uint8_t					inLine);
 	void					ClearLines(
 								uint8_t					inStartLine = 0,
 								uint8_t					inNumLines = 3);
@@ -21,7 +21,8 @@ namespace MyriadPro_Regular_36_1b
 		43,		// height, font height (ascent+descent+leading) in pixels
 		30,		// width, widest glyph advanceX within subset in pixels
 		9,		// numCharcodeRuns
-		55		// numCharCodes
+		55,		// numCharCodes
+		0		// runLength1Bit, 1 bit data is run length encoded
 	};
 	
 	const CharcodeRun	charcodeRun[] PROGMEM = // {start, entryIndex}, ...
@@ -0,0 +1,188 @@
+/*
+*	StorageLayout.cpp, Copyright Jonathan Mackey 2023
+*	Layout of the MCU's EEPROM and the AT24C serial EEPROM.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#include <EEPROM.h>
+#include <string.h>
+#include "StorageLayout.h"
+#include "HikeLocations.h"
+#include "DataStream.h"
+
+/******************************** ReadLocation ********************************/
+static bool ReadLocation(
+	DataStream*	inLocations,
+	uint16_t	inIndex,
+	uint16_t	inRecordSize,
+	void*		outLink)
+{
+	return(inLocations->Seek((uint32_t)inIndex * inRecordSize, DataStream::eSeekSet) &&
+		inLocations->Read(sizeof(SHikeLocationLink), outLink) == sizeof(SHikeLocationLink));
+}
+
+/******************************* HighestIndex *********************************/
+/*
+*	Returns the highest physical record index on the list starting at
+*	inIndex.  0xFFFF is returned if the list is corrupt.
+*/
+static uint16_t HighestIndex(
+	DataStream*	inLocations,
+	uint16_t	inIndex,
+	uint16_t	inRecordSize)
+{
+	uint16_t	capacity = Layout::kHikeLocations.size/inRecordSize;
+	uint16_t	highestIndex = 0;
+	SHikeLocationLink	link;
+	for (uint16_t count = 0; inIndex; count++)
+	{
+		if (inIndex >= capacity ||
+			count >= capacity ||
+			!ReadLocation(inLocations, inIndex, inRecordSize, &link))
+		{
+			highestIndex = 0xFFFF;
+			break;
+		}
+		if (inIndex > highestIndex)
+		{
+			highestIndex = inIndex;
+		}
+		inIndex = link.next;
+	}
+	return(highestIndex);
+}
+
+/****************************** ConvertLocations ******************************/
+/*
+*	Converts the location records to or from records followed by a CRC16.
+*	The physical record indexes don't change (the hike summaries reference
+*	locations by physical index), only the stride changes.  If a location in
+*	use won't fit within the new stride the locations are cleared and will
+*	need to be reloaded from SD.
+*/
+static bool ConvertLocations(
+	DataStream*	inLocations,
+	bool		inFromCRC)
+{
+	const uint16_t	kLinkSize = sizeof(SHikeLocationLink);
+	uint16_t	oldSize = inFromCRC ? kLinkSize + sizeof(uint16_t) : kLinkSize;
+	uint16_t	newSize = inFromCRC ? kLinkSize : kLinkSize + sizeof(uint16_t);
+	SHikeLocationRoot	root;
+	bool	success = ReadLocation(inLocations, 0, oldSize, &root);
+	if (success)
+	{
+		uint16_t	highestIndex = HighestIndex(inLocations, root.head, oldSize);
+		uint16_t	highestFreeIndex = HighestIndex(inLocations, root.freeHead, oldSize);
+		if (highestFreeIndex > highestIndex)
+		{
+			highestIndex = highestFreeIndex;
+		}
+		if (highestIndex < (Layout::kHikeLocations.size/newSize))
+		{
+			SHikeLocationLink	link;
+			/*
+			*	When the records grow they're moved starting from the last so
+			*	that a record isn't overwritten before it's moved.
+			*/
+			for (uint16_t i = 0; success && i <= highestIndex; i++)
+			{
+				uint16_t	index = newSize > oldSize ? highestIndex - i : i;
+				success = ReadLocation(inLocations, index, oldSize, &link) &&
+					inLocations->Seek((uint32_t)index * newSize, DataStream::eSeekSet);
+				if (success)
+				{
+				#ifdef HIKE_LOC_CRC
+					success = inLocations->WriteCRC(kLinkSize, &link);
+				#else
+					success = inLocations->Write(kLinkSize, &link) == kLinkSize;
+				#endif
+				}
+			}
+		} else
+		{
+			memset(&root, 0, sizeof(SHikeLocationRoot));
+			success = inLocations->Seek(0, DataStream::eSeekSet);
+			if (success)
+			{
+			#ifdef HIKE_LOC_CRC
+				success = inLocations->WriteCRC(kLinkSize, &root);
+			#else
+				success = inLocations->Write(kLinkSize, &root) == kLinkSize;
+			#endif
+			}
+		}
+	}
+	return(success);
+}
+
+/*********************************** Reset ************************************/
+void Layout::Reset(void)
+{
+	EEPROM.update(kLayoutVersion.start, kVersion);
+}
+
+/********************************** Migrate ***********************************/
+bool Layout::Migrate(
+	DataStream*	inLocations)
+{
+	uint8_t	version = EEPROM.read(kLayoutVersion.start);
+	bool	success = true;
+	if (version != kVersion)
+	{
+		/*
+		*	Version 1 -> 2
+		*	In version 1 the flags were at address 0, the same address as the
+		*	network ID.  The flags are set to their default (erased) state at
+		*	their new address.  Nothing else moved.  A new/erased EEPROM is
+		*	also handled here.
+		*/
+		if (version == 0xFF)
+		{
+			EEPROM.update(kFlags.start, 0xFF);
+			version = 2;
+		}
+		success = (version & 0x0F) == (kVersion & 0x0F);
+		if (success)
+		{
+			/*
+			*	If the location record format changed THEN
+			*	convert the records in place.
+			*/
+			if ((version ^ kVersion) & kLocationsCRCFlag)
+			{
+				success = ConvertLocations(inLocations, (version & kLocationsCRCFlag) != 0);
+			}
+			/*
+			*	If the log header format changed THEN
+			*	the log is reinitialized by HikeLog::Initialize.  Converting
+			*	the log in place would require shifting all of the log data
+			*	that follows each header.
+			*/
+			if ((version ^ kVersion) & kLogHeaderCRCFlag)
+			{
+				EEPROM.update(kLogInitialized.start, 0xFF);
+			}
+			if (success)
+			{
+				EEPROM.update(kLayoutVersion.start, kVersion);
+			}
+		}
+	}
+	return(success);
+}
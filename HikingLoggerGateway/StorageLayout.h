@@ -0,0 +1,148 @@
+/*
+*	StorageLayout.h, Copyright Jonathan Mackey 2023
+*	Layout of the MCU's EEPROM and the AT24C serial EEPROM.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef StorageLayout_h
+#define StorageLayout_h
+
+#include <inttypes.h>
+#include "HikeLog.h"
+
+class DataStream;
+
+/*
+*	Every region stored in the MCU's EEPROM and on the AT24C is defined here.
+*	The regions of each device are listed in address order in kEERegions and
+*	kAT24CRegions.  The static_asserts at the end of this file fail the build
+*	if any regions overlap, if a region extends past the end of its device, or
+*	if an AT24C region doesn't start on an AT24C page boundary.
+*
+*	The layout version is stored in kLayoutVersion.  An erased EEPROM byte
+*	(0xFF) is version 1, the layout used before the version was stamped.
+*	Migrate() is called at boot before any region is accessed.  It converts an
+*	older layout in place and then stamps the current version.
+*/
+namespace Layout
+{
+	struct SRegion
+	{
+		uint32_t	start;
+		uint32_t	size;
+		constexpr uint32_t		End(void) const
+									{return(start + size);}
+	};
+
+	/*
+	*	MCU EEPROM, 2K bytes (assumes ATmega644PA, E2END = 0x7FF)
+	*/
+	constexpr uint32_t	kEEPROMSize			= 2048;
+	constexpr SRegion	kNetworkID			= {0, 1};		// uint8_t
+	constexpr SRegion	kNodeID				= {1, 1};		// uint8_t
+	constexpr SRegion	kFlags				= {2, 1};		// uint8_t, see Config
+	constexpr SRegion	kLayoutVersion		= {3, 1};		// uint8_t
+	constexpr SRegion	kStartingLocIndex	= {4, 2};		// uint16_t
+	constexpr SRegion	kEndingLocIndex		= {6, 2};		// uint16_t
+	constexpr SRegion	kLogInitialized		= {8, 1};		// uint8_t
+	// Storage of the last n hikes, circular storage, 16 byte struct
+	constexpr uint16_t	kMaxHikeSummaries	= 125;
+	constexpr SRegion	kSummaryRingHeader	= {32, sizeof(SRingHeader)};
+	constexpr SRegion	kSummaryRing		= {38, sizeof(SHikeSummary) * kMaxHikeSummaries};
+
+	constexpr SRegion	kEERegions[] =
+	{
+		kNetworkID, kNodeID, kFlags, kLayoutVersion, kStartingLocIndex,
+		kEndingLocIndex, kLogInitialized, kSummaryRingHeader, kSummaryRing
+	};
+
+	/*
+	*	AT24C256, 32K bytes, 64 byte pages
+	*/
+	constexpr uint8_t	kAT24CDeviceAddr	= 0x50;
+	constexpr uint8_t	kAT24CCapacity		= 32;	// KB, value at end of AT24Cxxx xxx/8
+	constexpr uint16_t	kAT24CPageSize		= 64;
+	constexpr uint32_t	kAT24CSize			= (uint32_t)kAT24CCapacity * 1024;
+	// The number of locations is the size / the location record size, -1 for the root.
+	constexpr SRegion	kHikeLocations		= {0, 0x400};
+	// Rest of space for logs
+	constexpr SRegion	kHikeLog			= {kHikeLocations.End(), kAT24CSize - kHikeLocations.End()};
+
+	constexpr SRegion	kAT24CRegions[] =
+	{
+		kHikeLocations, kHikeLog
+	};
+
+	/*
+	*	The current layout version.  The low nibble is the layout version, the
+	*	high bits flag the optional record formats that change the size of the
+	*	stored records.
+	*/
+	constexpr uint8_t	kLocationsCRCFlag	= 0x40;
+	constexpr uint8_t	kLogHeaderCRCFlag	= 0x20;
+	constexpr uint8_t	kVersion			= 2
+#ifdef HIKE_LOC_CRC
+												| kLocationsCRCFlag
+#endif
+#ifdef HIKE_LOG_CRC
+												| kLogHeaderCRCFlag
+#endif
+												;
+
+	/*
+	*	Compile time checks.  C++11 constexpr functions are limited to a
+	*	single return statement, thus the recursion.
+	*/
+	constexpr bool			InOrder(
+								const SRegion*			inRegions,
+								uint8_t					inCount)
+							{return(inCount < 2 ||
+								(inRegions[0].End() <= inRegions[1].start &&
+									InOrder(&inRegions[1], inCount-1)));}
+	constexpr bool			PageAligned(
+								const SRegion*			inRegions,
+								uint8_t					inCount,
+								uint16_t				inPageSize)
+							{return(inCount == 0 ||
+								((inRegions[0].start % inPageSize) == 0 &&
+									PageAligned(&inRegions[1], inCount-1, inPageSize)));}
+
+	constexpr uint8_t	kNumEERegions = sizeof(kEERegions)/sizeof(SRegion);
+	constexpr uint8_t	kNumAT24CRegions = sizeof(kAT24CRegions)/sizeof(SRegion);
+	static_assert(InOrder(kEERegions, kNumEERegions), "MCU EEPROM regions overlap or are out of order");
+	static_assert(kEERegions[kNumEERegions-1].End() <= kEEPROMSize, "MCU EEPROM regions exceed the EEPROM size");
+	static_assert(InOrder(kAT24CRegions, kNumAT24CRegions), "AT24C regions overlap or are out of order");
+	static_assert(kAT24CRegions[kNumAT24CRegions-1].End() <= kAT24CSize, "AT24C regions exceed the AT24C size");
+	static_assert(PageAligned(kAT24CRegions, kNumAT24CRegions, kAT24CPageSize), "AT24C regions must start on a page boundary");
+
+	/*
+	*	Returns true if the stored layout is current, either because it
+	*	already was or because it was migrated.
+	*/
+	bool					Migrate(
+								DataStream*				inLocations);
+	/*
+	*	Stamps the current version over a layout that Migrate couldn't
+	*	convert.  The caller then reinitializes the log.  Any existing
+	*	location records may not be readable and should be updated from SD.
+	*/
+	void					Reset(void);
+}
+
+#endif // StorageLayout_h
@@ -109,7 +109,7 @@ void RemoteLogLayout::DrawLocation(
 void RemoteLogLayout::ClearLines1to3(void)
 {
 	mDisplay->MoveTo(0,0);
-	mDisplay->FillBlock(26*3, 180, eBlack);
+	mDisplay->EraseBlock(26*3, 180);
 }
 char* Int16ToDecStr(
 	int16_t	inNum,
@@ -122,10 +122,17 @@ void RemoteLogLayout::Update(
 	uint8_t	mode = mLogAction->Mode();
 	inUpdateAll = inUpdateAll || mode != mMode;
 	mMode = mode;
+	/*
+	*	Erased lines are deferred till the end of the frame so that only what
+	*	isn't redrawn is erased.
+	*/
+	mDisplay->BeginFrame();
 	
 	if (inUpdateAll)
 	{
 		ClearLines1to3();
+		mTimeField.Invalidate();
+		mAltitudeField.Invalidate();
 	}
 	
 	switch (mode)
@@ -163,7 +170,9 @@ void RemoteLogLayout::Update(
 				bool isPM = UnixTime::CreateTimeStr(timeStr);
 				MoveTo(0,29);
 				SetTextColor(eWhite);
+				SetTextField(&mTimeField);
 				DrawStr(timeStr);
+				SetTextField(nullptr);
 				uint8_t showingAMPM = UnixTime::Format24Hour() ? 0 : (isPM ? 1 : 2);
 				/*
 				*	If updating everything OR
@@ -219,7 +228,9 @@ void RemoteLogLayout::Update(
 					uint8_t charsInStr = LogTempPres::GetInstance().CreateAltitudeStr(altitude, altitudeStr);
 					MoveTo(2,0);
 					SetTextColor(eYellow);
+					SetTextField(&mAltitudeField);
 					DrawRightJustified(altitudeStr);
+					SetTextField(nullptr);
 				#ifndef DEBUG_RADIO
 					if (mHikeLog->Active())
 					{ 
@@ -480,8 +491,7 @@ void RemoteLogLayout::Update(
 			mDisplay->FillBlock(2, segWidth, busy ? eYellow:eBlack);
 		}
 	}
-	
-	
+	mDisplay->EndFrame();
 }
 
 char* Int16ToDecStr(
@@ -46,6 +46,8 @@ protected:
 	RemoteHikeLog*		mHikeLog;
 	Font*				mNormalFont;
 	Font*				mSmallFont;
+	TextField			mTimeField;
+	TextField			mAltitudeField;
 	uint8_t				mLogState;
 	uint8_t				mMode;
 	uint16_t			mLocIndex;
@@ -0,0 +1,9 @@
+/*
+*	Arduino.h, Copyright Jonathan Mackey 2023
+*	Redirects the Arduino core include of the display drivers to the host
+*	stand-in in HostSim when building DisplayBenchmark.
+*/
+#ifndef Arduino_h
+#define Arduino_h
+#include "ArduinoSim.h"
+#endif // Arduino_h
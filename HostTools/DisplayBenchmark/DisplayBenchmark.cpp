@@ -0,0 +1,267 @@
+/*
+*	DisplayBenchmark.cpp, Copyright Jonathan Mackey 2023
+*	Host (desktop) benchmark of the DisplayController drivers.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*	The unmodified drivers are linked against the simulated SPI and Wire
+*	buses in HostSim.  The Arduino.h, SPI.h and Wire.h in this directory
+*	redirect the drivers' includes to the simulations.  Each driver runs the
+*	same workload: a full display fill, text, lines, circles, and rounded
+*	rects.  The positions and sizes are scaled to the driver's display.  For
+*	each part of the workload the bus bytes, transactions, CS and DC pin
+*	toggles, and the time to clock the bytes at the bus clock are reported.
+*
+*	The SPI clock is the lesser of the driver's SPISettings clock and the
+*	MCU's maximum SPI clock (-c.)  The I2C clock is set by -i.
+*
+*	The 1 bit drivers don't implement CopyPixels, so nothing is sent for the
+*	anti-aliased lines and circles.
+*
+*	Build (host only, __MACH__):
+*	c++ -D__MACH__ -I. -I<dir of pgmspace_stub.h> -I../../libraries/XFont
+*		-I../../libraries/DataStream -I../../libraries/DisplayController
+*		-I../../libraries/HostSim -I../../HikingLoggerGateway
+*		DisplayBenchmark.cpp ../../libraries/XFont/XFont*.cpp
+*		../../libraries/DataStream/DataStream.cpp ../../libraries/DataStream/CRC16.cpp
+*		../../libraries/DisplayController/DisplayController.cpp
+*		../../libraries/DisplayController/TFT_*.cpp
+*		../../libraries/DisplayController/LCD_*.cpp
+*		../../libraries/DisplayController/OLED_SSD1306.cpp
+*		../../libraries/HostSim/ArduinoSim.cpp ../../libraries/HostSim/SPISim.cpp
+*		../../libraries/HostSim/WireSim.cpp -o DisplayBenchmark
+*
+*	Usage: DisplayBenchmark [-c max SPI clock Hz] [-i I2C clock Hz]
+*/
+#include "Arduino.h"
+#include "SPI.h"
+#include "Wire.h"
+#include "XFont.h"
+#include "TFT_ST7735S.h"
+#include "TFT_ST7789.h"
+#include "TFT_ILI9341.h"
+#include "TFT_ILI9488.h"
+#include "OLED_SSD1306.h"
+#include "LCD_ST7567.h"
+#include "LCD_PCD8544.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+XFont xFont;
+#include "MyriadPro-Regular_36_1b.h"
+
+static const pin_t		kDCPin = 1;		// PB1
+static const pin_t		kResetPin = 3;	// PB3
+static const pin_t		kCSPin = 4;		// PB4 (SS)
+static const uint8_t	kSSD1306Address = 0x3C;
+
+/*
+*	SSD1306Sim acknowledges everything sent to it.  Only the bus traffic is
+*	of interest.
+*/
+class SSD1306Sim : public WireSimDevice
+{
+public:
+	virtual bool			Acknowledge(
+								uint64_t				inBusTime)
+								{return(true);}
+	virtual void			Receive(
+								const uint8_t*			inData,
+								uint8_t					inLength,
+								uint64_t				inBusTime){}
+	virtual uint8_t			Transmit(
+								uint8_t					inLength,
+								uint8_t*				outData,
+								uint64_t				inBusTime)
+								{return(0);}
+};
+
+enum EWorkload
+{
+	eFill,
+	eText,
+	eLines,
+	eCircles,
+	eRoundedRects,
+	eNumWorkloads
+};
+
+static const char* const	kWorkloadNames[] =
+{
+	"fill", "text", "lines", "circles", "rounded rects"
+};
+
+/******************************** RunWorkload *********************************/
+/*
+*	Sizes are based on the display's rows and columns.  For the 1 bit drivers
+*	rows are pages (8 pixels.)
+*/
+static void RunWorkload(
+	DisplayController*	inDisplay,
+	uint8_t				inWorkload)
+{
+	int16_t	rows = inDisplay->GetRows();
+	int16_t	columns = inDisplay->GetColumns();
+	int16_t	minDim = rows < columns ? rows : columns;
+	switch (inWorkload)
+	{
+		case eFill:
+			inDisplay->Fill(XFont::eBlack);
+			break;
+		case eText:
+			inDisplay->MoveTo(0, 0);
+			xFont.DrawStr("12:59", true);
+			break;
+		case eLines:
+		{
+			for (int16_t i = 0; i <= 4; i++)
+			{
+				inDisplay->DrawLine(0, (rows-1)*i/4, columns-1, (rows-1)*(4-i)/4, 1);
+				inDisplay->DrawLine((columns-1)*i/4, 0, (columns-1)*(4-i)/4, rows-1, 2);
+			}
+			break;
+		}
+		case eCircles:
+		{
+			int16_t	radius = minDim/2 - 1;
+			inDisplay->DrawCircle(columns/2 - radius, rows/2 - radius, radius, 2);
+			radius /= 2;
+			inDisplay->DrawCircle(columns/2 - radius, rows/2 - radius, radius, radius);
+			break;
+		}
+		case eRoundedRects:
+		{
+			int16_t	inset = minDim/8;
+			int16_t	radius = minDim/8;
+			inDisplay->DrawRoundedRect(inset, inset, columns - inset*2,
+							rows - inset*2, radius, 255, true);
+			inset *= 2;
+			inDisplay->DrawRoundedRect(inset, inset, columns - inset*2,
+							rows - inset*2, radius/2, 200);
+			break;
+		}
+	}
+}
+
+/************************************ main ************************************/
+int main(
+	int		argc,
+	char*	argv[])
+{
+	uint32_t	maxSPIClock = 4000000;	// F_CPU/2 of an 8MHz ATmega644PA
+	uint32_t	i2cClock = 400000;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-c") == 0 && i+1 < argc && atoi(argv[i+1]) > 0)
+		{
+			maxSPIClock = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-i") == 0 && i+1 < argc && atoi(argv[i+1]) > 0)
+		{
+			i2cClock = atoi(argv[++i]);
+		} else
+		{
+			fprintf(stderr, "Usage: %s [-c max SPI clock Hz] [-i I2C clock Hz]\n", argv[0]);
+			return(1);
+		}
+	}
+	SPI.SetMaxClock(maxSPIClock);
+	Wire.setClock(i2cClock);
+	SSD1306Sim	ssd1306Sim;
+	Wire.AttachDevice(kSSD1306Address, &ssd1306Sim);
+
+	TFT_ST7735S	st7735s(kDCPin, kResetPin, kCSPin);
+	TFT_ST7789	st7789(kDCPin, kResetPin, kCSPin);
+	TFT_ILI9341	ili9341(kDCPin, kResetPin, kCSPin);
+	TFT_ILI9488	ili9488(kDCPin, kResetPin, kCSPin);
+	OLED_SSD1306	ssd1306(kSSD1306Address);
+	LCD_ST7567	st7567(kDCPin, kResetPin, kCSPin);
+	LCD_PCD8544	pcd8544(kDCPin, kResetPin, kCSPin);
+	st7735s.begin();
+	st7789.begin();
+	ili9341.begin();
+	ili9488.begin();
+	ssd1306.begin();
+	st7567.begin();
+	pcd8544.begin();
+
+	static const struct
+	{
+		const char*			name;
+		DisplayController*	display;
+		bool				isI2C;
+	} kDrivers[] =
+	{
+		{"ST7735S",	&st7735s,	false},
+		{"ST7789",	&st7789,	false},
+		{"ILI9341",	&ili9341,	false},
+		{"ILI9488",	&ili9488,	false},
+		{"SSD1306",	&ssd1306,	true},
+		{"ST7567",	&st7567,	false},
+		{"PCD8544",	&pcd8544,	false}
+	};
+	const uint8_t	kNumDrivers = sizeof(kDrivers)/sizeof(kDrivers[0]);
+
+	printf("%-8s %-14s %9s %8s %8s %8s %10s\n", "driver", "workload",
+		"bytes", "trans", "CS", "DC", "bus us");
+	for (uint8_t d = 0; d < kNumDrivers; d++)
+	{
+		DisplayController*	display = kDrivers[d].display;
+		xFont.SetDisplay(display, &MyriadPro_Regular_36_1b::font);
+		xFont.SetTextColor(XFont::eWhite);
+		xFont.SetBGTextColor(XFont::eBlack);
+		display->SetFGColor(XFont::eWhite);
+		display->SetBGColor(XFont::eBlack);
+		uint32_t	totalBytes = 0;
+		uint32_t	totalTransactions = 0;
+		uint64_t	totalBusTime = 0;
+		for (uint8_t workload = 0; workload < eNumWorkloads; workload++)
+		{
+			uint32_t	bytes, transactions, csToggles = 0, dcToggles = 0;
+			uint64_t	busTime;
+			if (kDrivers[d].isI2C)
+			{
+				Wire.ResetStats();
+				busTime = Wire.BusTime();
+				RunWorkload(display, workload);
+				busTime = Wire.BusTime() - busTime;
+				bytes = Wire.BytesTransferred();
+				transactions = Wire.Transmissions();
+			} else
+			{
+				SPI.ResetStats();
+				busTime = SPI.BusTime();
+				RunWorkload(display, workload);
+				busTime = SPI.BusTime() - busTime;
+				bytes = SPI.BytesTransferred();
+				transactions = SPI.Transactions();
+				csToggles = SPI.PinToggles(kCSPin);
+				dcToggles = SPI.PinToggles(kDCPin);
+			}
+			printf("%-8s %-14s %9u %8u %8u %8u %10.1f\n", kDrivers[d].name,
+				kWorkloadNames[workload], bytes, transactions, csToggles,
+				dcToggles, busTime/1000.0);
+			totalBytes += bytes;
+			totalTransactions += transactions;
+			totalBusTime += busTime;
+		}
+		printf("%-8s %-14s %9u %8u %8s %8s %10.1f\n", kDrivers[d].name,
+			"total", totalBytes, totalTransactions, "", "", totalBusTime/1000.0);
+	}
+	return(0);
+}
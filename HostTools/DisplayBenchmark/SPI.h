@@ -0,0 +1,9 @@
+/*
+*	SPI.h, Copyright Jonathan Mackey 2023
+*	Redirects the Arduino SPI library include of the display drivers to the host
+*	stand-in in HostSim when building DisplayBenchmark.
+*/
+#ifndef SPI_h
+#define SPI_h
+#include "SPISim.h"
+#endif // SPI_h
@@ -0,0 +1,9 @@
+/*
+*	Wire.h, Copyright Jonathan Mackey 2023
+*	Redirects the Arduino Wire library include of the display drivers to the host
+*	stand-in in HostSim when building DisplayBenchmark.
+*/
+#ifndef Wire_h
+#define Wire_h
+#include "WireSim.h"
+#endif // Wire_h
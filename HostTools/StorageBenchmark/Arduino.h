@@ -0,0 +1,9 @@
+/*
+*	Arduino.h, Copyright Jonathan Mackey 2023
+*	Redirects the Arduino core include to the host stand-in in HostSim when
+*	building StorageBenchmark.
+*/
+#ifndef Arduino_h
+#define Arduino_h
+#include "ArduinoSim.h"
+#endif // Arduino_h
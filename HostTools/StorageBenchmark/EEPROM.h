@@ -0,0 +1,43 @@
+/*
+*	EEPROM.h, Copyright Jonathan Mackey 2023
+*	Host stand-in for the AVR EEPROM library when building StorageBenchmark.
+*	The 4KB of the ATmega644PA EEPROM is held in RAM, initially erased.
+*/
+#ifndef EEPROM_h
+#define EEPROM_h
+#include <inttypes.h>
+#include <string.h>
+
+class EEPROMClass
+{
+public:
+	static const uint16_t	kSize = 4096;
+							EEPROMClass(void)
+								{memset(mMemory, 0xFF, kSize);}
+	uint8_t					read(
+								int						inAddress)
+								{return(mMemory[inAddress]);}
+	void					write(
+								int						inAddress,
+								uint8_t					inValue)
+								{mMemory[inAddress] = inValue;}
+	void					update(
+								int						inAddress,
+								uint8_t					inValue)
+								{mMemory[inAddress] = inValue;}
+	template<typename T> T&	get(
+								int						inAddress,
+								T&						outValue)
+								{memcpy(&outValue, &mMemory[inAddress], sizeof(T));
+								 return(outValue);}
+	template<typename T> const T& put(
+								int						inAddress,
+								const T&				inValue)
+								{memcpy(&mMemory[inAddress], &inValue, sizeof(T));
+								 return(inValue);}
+protected:
+	uint8_t	mMemory[kSize];
+};
+
+extern EEPROMClass EEPROM;
+#endif // EEPROM_h
@@ -0,0 +1,66 @@
+/*
+*	SdFat.h, Copyright Jonathan Mackey 2023
+*	Host stand-in for the SdFat library when building StorageBenchmark.  There
+*	is no card, begin always fails, so only the AT24C traffic is measured.
+*	Serial and F() normally reach HikeLog.cpp via the SdFat includes.
+*/
+#ifndef SdFat_h
+#define SdFat_h
+#include "Arduino.h"
+#include <string.h>
+
+#define O_RDONLY	0
+#define O_WRONLY	1
+#define O_CREAT		0x40
+#define F(s)		(s)
+
+class SdFat
+{
+public:
+	bool					begin(
+								uint8_t					inCSPin)
+								{return(false);}
+	void					initErrorHalt(void){}
+	bool					remove(
+								const char*				inPath)
+								{return(false);}
+};
+
+class SdFile
+{
+public:
+	static void				dateTimeCallback(
+								void					(*inCallback)(uint16_t*, uint16_t*)){}
+	bool					open(
+								const char*				inPath,
+								int						inFlags)
+								{return(false);}
+	void					close(void){}
+	int						read(
+								void*					outBuffer,
+								size_t					inLength)
+								{return(-1);}
+	size_t					write(
+								const void*				inBuffer,
+								size_t					inLength)
+								{return(0);}
+	uint32_t				curPosition(void) const
+								{return(0);}
+	uint32_t				fileSize(void) const
+								{return(0);}
+};
+
+class SerialSim
+{
+public:
+	template<typename T> void print(
+								T						inValue,
+								int						inFormat = 0){}
+	template<typename T> void println(
+								T						inValue,
+								int						inFormat = 0){}
+	void					println(void){}
+};
+
+extern SerialSim Serial;
+#endif // SdFat_h
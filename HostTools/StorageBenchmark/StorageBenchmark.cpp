@@ -0,0 +1,256 @@
+/*
+*	StorageBenchmark.cpp, Copyright Jonathan Mackey 2023
+*	Host (desktop) benchmark of the gateway's AT24C storage workloads.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*	The unmodified HikeLocations, HikeLog, AT24CDataStream and AT24C code is
+*	run against the simulated AT24C (AT24CSim) on the simulated I2C bus
+*	(WireSim.)  The storage layout is the gateway's (StorageLayout.h.)  The
+*	EEPROM.h, SdFat.h, Arduino.h and Wire.h in this directory redirect the
+*	includes to host stand-ins.  There is no SD card, so only the AT24C
+*	traffic is measured.
+*
+*	Workloads:
+*	- locations: the locations region is cleared then the locations are
+*	  added in the order read from an unsorted CSV (as LoadFromSD does.)
+*	- browse: Next through every location.
+*	- hikes: the gateway's logging loop.  The time advances one second per
+*	  pass and LogEntryIfTime is called on each pass.  Each hike is started
+*	  and ended the way the UI does it.  When the log is full it's cleared, as
+*	  it would be after being saved to SD.
+*
+*	For each workload the bus time (including the write cycle polling), the
+*	I2C transmissions and NACKs, the bytes written and read, the write cycles,
+*	and the write count of the most written page are reported.  The wear of
+*	the hikes workload is reported relative to the chip's rated endurance
+*	along with the number of hikes it would take to reach it.
+*
+*	Build (host only, __MACH__ selects the host paths of the gateway code):
+*	c++ -D__MACH__ -I. -I<dir of pgmspace_stub.h> -I../../HikingLoggerGateway
+*		-I../../libraries/AT24C -I../../libraries/DataStream
+*		-I../../libraries/HostSim -I../../libraries/LoggerUtils
+*		-I../../libraries/UnixTime -I../../libraries/CSVUtils
+*		StorageBenchmark.cpp ../../HikingLoggerGateway/HikeLog.cpp
+*		../../libraries/LoggerUtils/HikeLocations.cpp
+*		../../libraries/LoggerUtils/LogTempPres.cpp
+*		../../libraries/LoggerUtils/BMP280Utils.cpp
+*		../../libraries/AT24C/AT24C.cpp ../../libraries/AT24C/AT24CDataStream.cpp
+*		../../libraries/AT24C/AT24CSim.cpp ../../libraries/DataStream/DataStream.cpp
+*		../../libraries/DataStream/CRC16.cpp ../../libraries/HostSim/WireSim.cpp
+*		-o StorageBenchmark
+*
+*	Usage: StorageBenchmark [-i I2C clock Hz] [-n hikes] [-m hike minutes]
+*/
+#include "Wire.h"
+#include "EEPROM.h"
+#include "SdFat.h"
+#include "AT24C.h"
+#include "AT24CDataStream.h"
+#include "HikeLocations.h"
+#include "HikeLog.h"
+#include "LogTempPres.h"
+#include "UnixTime.h"
+#include "StorageLayout.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+EEPROMClass	EEPROM;
+SerialSim	Serial;
+
+/*
+*	UnixTime.cpp's host path depends on CoreFoundation.  Only the clock is
+*	needed by the storage code.  It starts at 2023-01-01 08:00 UTC.
+*/
+time32_t	UnixTime::sTime = 1672560000;
+bool		UnixTime::sTimeChanged;
+void UnixTime::SDFatDateTime(
+	time32_t	inTime,
+	uint16_t*	outDate,
+	uint16_t*	outTime)
+{
+	*outDate = 0;
+	*outTime = 0;
+}
+
+AT24C			at24C(Layout::kAT24CDeviceAddr, Layout::kAT24CCapacity);
+AT24CDataStream	locationsDataStream(&at24C, (const void*)(uintptr_t)Layout::kHikeLocations.start, Layout::kHikeLocations.size);
+AT24CDataStream	logDataStream(&at24C, (const void*)(uintptr_t)Layout::kHikeLog.start, Layout::kHikeLog.size);
+HikeLog			hikeLog;
+
+static const uint8_t	kSDSelectPin = 0;
+static const uint16_t	kNumLocations = 40;	// The region holds 41 + the root
+static const uint32_t	kSeaLevelPressure = 101325;	// Pa
+
+enum EWorkload
+{
+	eLocations,
+	eBrowse,
+	eHikes,
+	eNumWorkloads
+};
+
+static const char* const	kWorkloadNames[] =
+{
+	"locations", "browse", "hikes"
+};
+
+/******************************* AddLocations *********************************/
+/*
+*	Clears the locations region then adds kNumLocations.  The names are
+*	added out of order so the sorted insert walks the list.  Location n is at
+*	n * 250 feet.
+*/
+static void AddLocations(void)
+{
+	SHikeLocationRoot	root;
+	memset(&root, 0, sizeof(root));
+	locationsDataStream.Seek(0, DataStream::eSeekSet);
+	locationsDataStream.Write(sizeof(root), &root);
+	HikeLocations::GetInstance().Initialize(&locationsDataStream, kSDSelectPin);
+	for (uint16_t i = 0; i < kNumLocations; i++)
+	{
+		uint16_t	n = (i * 17) % kNumLocations;	// 17 is coprime to 40
+		SHikeLocationLink	location;
+		location.loc.elevation = n * 250;
+		snprintf(location.loc.name, sizeof(location.loc.name), "%s PEAK %02u",
+			(n & 1) ? "MT" : "WEST", n);
+		HikeLocations::GetInstance().Add(location);
+	}
+}
+
+/*********************************** Hike *************************************/
+/*
+*	Hikes from the lowest location to the highest.  The pressure drops
+*	linearly (about 12Pa/m) so every milestone is passed.
+*/
+static void Hike(
+	uint32_t	inSeconds)
+{
+	LogTempPres&	logTempPres = LogTempPres::GetInstance();
+	logTempPres.Set(2000, kSeaLevelPressure);
+	HikeLocations::GetInstance().GoToNthLocation(0);
+	hikeLog.StartingLocIndex() = HikeLocations::GetInstance().GetCurrentIndex();
+	HikeLocations::GetInstance().GoToNthLocation(kNumLocations-1);
+	hikeLog.EndingLocIndex() = HikeLocations::GetInstance().GetCurrentIndex();
+	uint32_t	pressureDrop = (uint32_t)((kNumLocations-1) * 250 * 0.3048 * 12);
+	if (hikeLog.StartLog())
+	{
+		for (uint32_t second = 1; second <= inSeconds; second++)
+		{
+			UnixTime::Tick();
+			logTempPres.Set(2000 - (int32_t)(second * 1000 / inSeconds),
+				kSeaLevelPressure - (uint32_t)((uint64_t)pressureDrop * second / inSeconds));
+			hikeLog.LogEntryIfTime();
+		}
+		hikeLog.StopLog();
+		hikeLog.EndLog();
+	} else
+	{
+		fprintf(stderr, "StartLog failed\n");
+	}
+	if (hikeLog.IsFull())
+	{
+		hikeLog.InitializeLog();
+	}
+	/*
+	*	The rest of the day.
+	*/
+	for (uint32_t second = inSeconds; second < 86400; second++)
+	{
+		UnixTime::Tick();
+	}
+}
+
+/************************************ main ************************************/
+int main(
+	int		argc,
+	char*	argv[])
+{
+	uint32_t	i2cClock = 400000;
+	uint32_t	hikes = 10;
+	uint32_t	hikeMinutes = 240;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-i") == 0 && i+1 < argc && atoi(argv[i+1]) > 0)
+		{
+			i2cClock = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-n") == 0 && i+1 < argc && atoi(argv[i+1]) > 0)
+		{
+			hikes = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-m") == 0 && i+1 < argc && atoi(argv[i+1]) > 0)
+		{
+			hikeMinutes = atoi(argv[++i]);
+		} else
+		{
+			fprintf(stderr, "Usage: %s [-i I2C clock Hz] [-n hikes] [-m hike minutes]\n", argv[0]);
+			return(1);
+		}
+	}
+	Wire.setClock(i2cClock);
+	AT24CSim&	sim = at24C.Sim();
+
+	printf("%-10s %10s %8s %8s %9s %9s %8s %9s\n", "workload", "bus ms",
+		"trans", "NACKs", "written", "read", "cycles", "max page");
+	for (uint8_t workload = 0; workload < eNumWorkloads; workload++)
+	{
+		Wire.ResetStats();
+		sim.ResetStats();
+		uint64_t	busTime = Wire.BusTime();
+		switch (workload)
+		{
+			case eLocations:
+				AddLocations();
+				break;
+			case eBrowse:
+				HikeLocations::GetInstance().GoToNthLocation(0);
+				for (uint16_t i = 1; i < kNumLocations; i++)
+				{
+					HikeLocations::GetInstance().Next(false);
+				}
+				break;
+			case eHikes:
+				hikeLog.Initialize(&logDataStream, kSDSelectPin);
+				for (uint32_t hike = 0; hike < hikes; hike++)
+				{
+					Hike(hikeMinutes * 60);
+				}
+				break;
+		}
+		busTime = Wire.BusTime() - busTime;
+		printf("%-10s %10.1f %8u %8u %9u %9u %8u %9u\n", kWorkloadNames[workload],
+			busTime/1000000.0, Wire.Transmissions(), Wire.Nacks(),
+			sim.BytesWritten(), sim.BytesRead(), sim.WriteCycles(),
+			sim.MaxPageWriteCount());
+	}
+
+	/*
+	*	The sim's stats are for the hikes workload at this point.
+	*/
+	uint32_t	maxPageWrites = sim.MaxPageWriteCount();
+	printf("\n%u hikes of %u minutes: %.4f%% of the %u cycle endurance used, %u worn pages\n",
+		hikes, hikeMinutes, sim.EndurancePercentUsed(), AT24CSim::kEndurance,
+		sim.WornPages());
+	if (maxPageWrites)
+	{
+		printf("Hikes until the most written page reaches the endurance: %.0f\n",
+			(double)AT24CSim::kEndurance * hikes / maxPageWrites);
+	}
+	return(0);
+}
@@ -0,0 +1,236 @@
+/*
+*	XFontBenchmark.cpp, Copyright Jonathan Mackey 2023
+*	Host (desktop) benchmark of the gateway screens drawn by XFont.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*	Draws the gateway's main screen fields (location names, clock,
+*	temperature and altitude) using the same positions, colors and font as
+*	LogUI into a FrameBufferSim.  For each frame the pixels, SPI commands,
+*	SPI data bytes, SPI transactions, the time to clock the bytes at the SPI
+*	clock, and the host time to draw the frame are reported.  The framebuffer
+*	hash is also reported and, when a snapshot directory is passed, each frame
+*	is written as a PNG for regression comparison.
+*
+*	Each frame is drawn starting from the state left by the frames before it.
+*	Only the drawing of the frame itself is measured.
+*
+*	Build (host only, __MACH__):
+*	c++ -D__MACH__ -I<dir of pgmspace_stub.h> -I../../libraries/XFont
+*		-I../../libraries/DataStream -I../../libraries/DisplayController
+*		-I../../libraries/HostSim -I../../HikingLoggerGateway
+*		XFontBenchmark.cpp ../../libraries/XFont/XFont*.cpp
+*		../../libraries/DataStream/DataStream.cpp ../../libraries/DataStream/CRC16.cpp
+*		../../libraries/DisplayController/DisplayController.cpp
+*		../../libraries/HostSim/FrameBufferSim.cpp -o XFontBenchmark
+*
+*	Usage: XFontBenchmark [-n iterations] [-c SPI clock Hz] [-w] [-o dir]
+*		-w	Enables the XFont single window mode.
+*		-o	Writes a PNG of each frame to dir.
+*/
+#include "pgmspace_stub.h"
+#include "FrameBufferSim.h"
+#include "XFont.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+XFont xFont;
+#include "MyriadPro-Regular_36_1b.h"
+
+// LogUI's layout, 5 lines of 43 pixels on a 240 x 240 display.
+static const uint16_t	kLineHeight = 43;
+static const uint16_t	kDisplaySize = 240;
+static const uint16_t	kClockRow = kDisplaySize - (kLineHeight*2);
+static const uint16_t	kBottomRow = kDisplaySize - kLineHeight;
+
+struct SFrameState
+{
+	const char*	startName;
+	const char*	endName;
+	const char*	time;
+	const char*	temperature;
+	const char*	altitude;
+};
+
+static XFont::TextField	sTimeField;
+static XFont::TextField	sAltitudeField;
+
+/******************************** DrawFields **********************************/
+/*
+*	Draws the fields of inState that differ from inPrevState, all of them
+*	when inPrevState is nullptr.
+*/
+static void DrawFields(
+	DisplayController*	inDisplay,
+	const SFrameState*	inState,
+	const SFrameState*	inPrevState)
+{
+	if (!inPrevState)
+	{
+		inDisplay->Fill(XFont::eBlack);
+		inDisplay->MoveTo(kClockRow-13, 0);
+		inDisplay->FillBlock(2, kDisplaySize, XFont::eGray);
+		sTimeField.Invalidate();
+		sAltitudeField.Invalidate();
+	}
+	if (!inPrevState || strcmp(inState->startName, inPrevState->startName))
+	{
+		xFont.MoveTo(1);
+		xFont.SetTextColor(XFont::eGreen);
+		xFont.DrawStr(inState->startName, true);
+	}
+	if (!inPrevState || strcmp(inState->endName, inPrevState->endName))
+	{
+		xFont.MoveTo(2);
+		xFont.SetTextColor(XFont::eRed);
+		xFont.DrawStr(inState->endName, true);
+	}
+	if (!inPrevState || strcmp(inState->time, inPrevState->time))
+	{
+		inDisplay->MoveTo(kClockRow, 45);
+		xFont.SetTextColor(XFont::eWhite);
+		xFont.SetTextField(&sTimeField);
+		xFont.DrawStr(inState->time);
+		xFont.SetTextField(nullptr);
+	}
+	if (!inPrevState || strcmp(inState->temperature, inPrevState->temperature))
+	{
+		inDisplay->MoveTo(kBottomRow, 0);
+		xFont.SetTextColor(XFont::eMagenta);
+		xFont.DrawStr(inState->temperature);
+		xFont.EraseTillColumn(86);
+	}
+	if (!inPrevState || strcmp(inState->altitude, inPrevState->altitude))
+	{
+		inDisplay->MoveTo(kBottomRow, 0);
+		xFont.SetTextColor(XFont::eYellow);
+		xFont.SetTextField(&sAltitudeField);
+		xFont.DrawRightJustified(inState->altitude);
+		xFont.SetTextField(nullptr);
+	}
+}
+
+/************************************ main ************************************/
+int main(
+	int		argc,
+	char*	argv[])
+{
+	static const struct
+	{
+		const char*	name;
+		SFrameState	state;
+	} kFrames[] =
+	{
+		{"screen",		{"BOOTJACK", "MT TAM PEAK", "12:59", "72°F", "1479'"}},
+		{"clock",		{"BOOTJACK", "MT TAM PEAK", "1:00", "72°F", "1479'"}},
+		{"clock_tick",	{"BOOTJACK", "MT TAM PEAK", "1:01", "72°F", "1479'"}},
+		{"altitude",	{"BOOTJACK", "MT TAM PEAK", "1:01", "72°F", "1482'"}},
+		{"temperature",	{"BOOTJACK", "MT TAM PEAK", "1:01", "71°F", "1482'"}},
+		{"locations",	{"ROCK SPRING", "WEST POINT", "1:01", "71°F", "1482'"}}
+	};
+	const uint8_t	kNumFrames = sizeof(kFrames)/sizeof(kFrames[0]);
+	uint32_t	iterations = 100;
+	uint32_t	spiClock = 4000000;	// F_CPU/2 of an 8MHz ATmega644PA
+	bool		singleWindowMode = false;
+	const char*	snapshotDir = nullptr;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i+1 < argc)
+		{
+			iterations = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-c") == 0 && i+1 < argc && atoi(argv[i+1]) > 0)
+		{
+			spiClock = atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-w") == 0)
+		{
+			singleWindowMode = true;
+		} else if (strcmp(argv[i], "-o") == 0 && i+1 < argc)
+		{
+			snapshotDir = argv[++i];
+		} else
+		{
+			fprintf(stderr, "Usage: %s [-n iterations] [-c SPI clock Hz] [-w] [-o dir]\n", argv[0]);
+			return(1);
+		}
+	}
+	if (iterations == 0)
+	{
+		iterations = 1;
+	}
+	FrameBufferSim	display(kDisplaySize, kDisplaySize);
+	xFont.SetDisplay(&display, &MyriadPro_Regular_36_1b::font);
+	xFont.SetSingleWindowMode(singleWindowMode);
+	xFont.SetBGTextColor(XFont::eBlack);
+
+	printf("%-12s %8s %8s %10s %8s %9s %9s  %s\n", "frame", "pixels",
+		"commands", "data bytes", "trans", "SPI us", "host us", "hash");
+	FrameBufferSim::SStats	total = {0};
+	uint64_t	totalSPITime = 0;
+	double		totalHostTime = 0;
+	for (uint8_t frame = 0; frame < kNumFrames; frame++)
+	{
+		const SFrameState*	prevState = frame ? &kFrames[frame-1].state : nullptr;
+		double	hostTime = 0;
+		for (uint32_t i = 0; i < iterations; i++)
+		{
+			/*
+			*	Restore the display and text fields to the previous frame.
+			*/
+			if (prevState)
+			{
+				DrawFields(&display, &kFrames[0].state, nullptr);
+				for (uint8_t f = 1; f < frame; f++)
+				{
+					DrawFields(&display, &kFrames[f].state, &kFrames[f-1].state);
+				}
+			}
+			display.ResetStats();
+			std::chrono::steady_clock::time_point	start = std::chrono::steady_clock::now();
+			DrawFields(&display, &kFrames[frame].state, prevState);
+			hostTime += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+		}
+		hostTime /= iterations;
+		const FrameBufferSim::SStats&	stats = display.Stats();
+		uint64_t	spiTime = display.SPITime(spiClock);
+		printf("%-12s %8u %8u %10u %8u %9.1f %9.2f  %08X\n", kFrames[frame].name,
+			stats.pixels, stats.commands, stats.dataBytes, stats.transactions,
+			spiTime/1000.0, hostTime, display.Hash());
+		total.pixels += stats.pixels;
+		total.commands += stats.commands;
+		total.dataBytes += stats.dataBytes;
+		total.transactions += stats.transactions;
+		totalSPITime += spiTime;
+		totalHostTime += hostTime;
+		if (snapshotDir)
+		{
+			char	path[1024];
+			snprintf(path, sizeof(path), "%s/%s.png", snapshotDir, kFrames[frame].name);
+			if (!display.WritePNG(path))
+			{
+				fprintf(stderr, "Unable to write %s\n", path);
+				return(1);
+			}
+		}
+	}
+	printf("%-12s %8u %8u %10u %8u %9.1f %9.2f\n", "total",
+		total.pixels, total.commands, total.dataBytes, total.transactions,
+		totalSPITime/1000.0, totalHostTime);
+	return(0);
+}
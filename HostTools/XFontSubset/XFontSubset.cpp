@@ -0,0 +1,765 @@
+/*
+*	XFontSubset.cpp, Copyright Jonathan Mackey 2023
+*	Host (desktop) tool that regenerates a font header containing only the
+*	glyphs needed to draw the strings of a sketch.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*	The font header is one created by SubsetFontCreator (or by this tool.)
+*	The charcodes used are collected from:
+*	- The string literals of the source files passed, including the PROGMEM
+*	  strings referenced by tables such as LogUI's SString_PDesc arrays.
+*	  Strings passed to F() (Serial debug output), character constants,
+*	  comments and #include file names are ignored.
+*	- The name field of a hike locations CSV (see HikeLocations::LoadFromSD.)
+*	- A range string of charcodes drawn that aren't in any literal, such as
+*	  the digits of numbers formatted at runtime.  The format of the range
+*	  string is the same as used by SubsetFontCreator and XFont::WidestGlyph,
+*	  pairs of start and end characters, e.g. "09AZ".
+*	Control characters are ignored.
+*
+*	The regenerated header has the same layout and namespace as the source
+*	header.  The charcode runs are rebuilt from the charcodes used, so there
+*	is one run per range of consecutive charcodes.  Fewer runs means less
+*	flash and a shorter binary search in XFont::FindGlyph.  The glyph data is
+*	copied as is, so 1 bit, antialiased and run length encoded fonts are all
+*	supported.  Charcodes used that the source font doesn't contain are
+*	listed on stderr and are left out.
+*
+*	Build (host only):
+*	c++ -std=c++11 XFontSubset.cpp -o XFontSubset
+*
+*	Usage: XFontSubset -f font.h [-o out.h] [-c locations.csv] [-r range]
+*			[source files...]
+*	Example:
+*	XFontSubset -f MyriadPro-Regular_36_1b.h -c HikeLocations.csv
+*		-r "09--.." LogUI.cpp ../libraries/LoggerUtils/LogTempPres.cpp
+*/
+#include <set>
+#include <string>
+#include <vector>
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef std::set<uint16_t>	CharcodeSet;
+
+struct SFontSource
+{
+	std::string				text;			// The entire font header
+	std::vector<int32_t>	header;			// FontHeader field values
+	std::vector<int32_t>	charcodeRuns;	// {start, entryIndex} pairs
+	std::vector<int32_t>	glyphDataOffsets;
+	std::vector<int32_t>	glyphData;
+	std::string::size_type	headerStart;	// Start of "const FontHeader"
+	std::string::size_type	tablesEnd;		// After the glyphData table
+};
+
+// FontHeader field indexes (see XFontGlyph.h)
+enum
+{
+	eVersion,
+	eOneBit,
+	eRotated,
+	eHorizontal,
+	eMonospaced,
+	eAscent,
+	eDescent,
+	eHeight,
+	eWidth,
+	eNumCharcodeRuns,
+	eNumCharCodes,
+	eRunLength1Bit
+};
+
+/********************************* ReadFile ***********************************/
+static bool ReadFile(
+	const char*		inPath,
+	std::string&	outText)
+{
+	FILE*	file = fopen(inPath, "rb");
+	bool	success = file != nullptr;
+	if (success)
+	{
+		char	buffer[4096];
+		size_t	bytesRead;
+		outText.clear();
+		while ((bytesRead = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		{
+			outText.append(buffer, bytesRead);
+		}
+		fclose(file);
+	} else
+	{
+		fprintf(stderr, "Unable to open %s\n", inPath);
+	}
+	return(success);
+}
+
+/********************************** NextChar **********************************/
+/*
+*	Same as XFont::NextChar.  Handles 1, 2, and 3 byte UTF-8 sequences.
+*/
+static uint16_t NextChar(
+	const char*&	inUTF8Str)
+{
+	uint16_t	nextChar = 0;
+	const uint8_t* strPtr = (uint8_t*)inUTF8Str;
+	uint16_t codepoint = *(strPtr++);
+	if (codepoint)
+	{
+		if ((codepoint & 0x80) == 0)
+		{
+			nextChar = codepoint;
+		} else if ((codepoint & 0xE0) == 0xC0 && strPtr[0])
+		{
+			nextChar = (uint16_t)(((codepoint & 0x1F) << 6) +
+							((uint16_t)(*(strPtr++)) & 0x3F));
+		} else if ((codepoint & 0xF0) == 0xE0 && strPtr[0] && strPtr[1])
+		{
+			nextChar = (uint16_t)(((codepoint & 0x0F) << 0xC) +
+							(((uint16_t)(strPtr[0]) & 0x3F) << 6) +
+								((uint16_t)(strPtr[1]) & 0x3F));
+			strPtr+=2;
+		}
+		inUTF8Str = (const char*)strPtr;
+	}
+	return(nextChar);
+}
+
+/********************************* AddString **********************************/
+static void AddString(
+	const std::string&	inUTF8Str,
+	CharcodeSet&		ioCharcodes)
+{
+	const char*	strPtr = inUTF8Str.c_str();
+	for (uint16_t charcode = NextChar(strPtr); charcode;
+								charcode = NextChar(strPtr))
+	{
+		if (charcode >= ' ')
+		{
+			ioCharcodes.insert(charcode);
+		}
+	}
+}
+
+/********************************** AddRange **********************************/
+static bool AddRange(
+	const char*		inUTF8RangeStr,
+	CharcodeSet&	ioCharcodes)
+{
+	bool	success = true;
+	const char*	strPtr = inUTF8RangeStr;
+	for (uint16_t startChar = NextChar(strPtr); startChar;
+								startChar = NextChar(strPtr))
+	{
+		uint16_t	endChar = NextChar(strPtr);
+		success = startChar <= endChar;
+		if (success)
+		{
+			for (uint32_t charcode = startChar; charcode <= endChar; charcode++)
+			{
+				ioCharcodes.insert((uint16_t)charcode);
+			}
+			continue;
+		}
+		fprintf(stderr, "Invalid range string \"%s\"\n", inUTF8RangeStr);
+		break;
+	}
+	return(success);
+}
+
+/********************************* IsFMacro ***********************************/
+/*
+*	Returns true if the literal starting at inQuote is the argument of F().
+*/
+static bool IsFMacro(
+	const std::string&		inText,
+	std::string::size_type	inQuote)
+{
+	std::string::size_type	i = inQuote;
+	while (i && isspace((uint8_t)inText[i-1]))i--;
+	bool	isFMacro = i && inText[i-1] == '(';
+	if (isFMacro)
+	{
+		i--;
+		while (i && isspace((uint8_t)inText[i-1]))i--;
+		isFMacro = i && inText[i-1] == 'F' &&
+			(i == 1 || !(isalnum((uint8_t)inText[i-2]) || inText[i-2] == '_'));
+	}
+	return(isFMacro);
+}
+
+/******************************** ScanSource **********************************/
+/*
+*	Adds the charcodes of the string literals in inText.
+*	Adjacent literals are not concatenated, they don't need to be.
+*/
+static void ScanSource(
+	const std::string&	inText,
+	CharcodeSet&		ioCharcodes)
+{
+	std::string::size_type	length = inText.size();
+	std::string::size_type	i = 0;
+	bool	lineStart = true;
+	while (i < length)
+	{
+		char	thisChar = inText[i];
+		if (thisChar == '/' && i+1 < length && inText[i+1] == '/')
+		{
+			i = inText.find('\n', i);
+			if (i == std::string::npos)
+			{
+				break;
+			}
+			continue;
+		}
+		if (thisChar == '/' && i+1 < length && inText[i+1] == '*')
+		{
+			i = inText.find("*/", i+2);
+			if (i == std::string::npos)
+			{
+				break;
+			}
+			i += 2;
+			continue;
+		}
+		if (lineStart && thisChar == '#')
+		{
+			std::string::size_type	directive = i+1;
+			while (directive < length && isblank((uint8_t)inText[directive]))directive++;
+			if (inText.compare(directive, 7, "include") == 0)
+			{
+				i = inText.find('\n', i);
+				if (i == std::string::npos)
+				{
+					break;
+				}
+				continue;
+			}
+		}
+		if (thisChar == '\n')
+		{
+			lineStart = true;
+		} else if (!isspace((uint8_t)thisChar))
+		{
+			lineStart = false;
+		}
+		if (thisChar != '"' && thisChar != '\'')
+		{
+			i++;
+			continue;
+		}
+		/*
+		*	Decode the literal's escape sequences.  Non-ASCII characters
+		*	are assumed to be UTF-8 encoded within the source file.
+		*/
+		std::string::size_type	quote = i;
+		std::string	literal;
+		for (i++; i < length && inText[i] != thisChar; i++)
+		{
+			if (inText[i] != '\\' || i+1 >= length)
+			{
+				literal += inText[i];
+				continue;
+			}
+			char	escChar = inText[++i];
+			switch (escChar)
+			{
+				case 'n':
+				case 'r':
+				case 't':
+				case 'a':
+				case 'b':
+				case 'f':
+				case 'v':
+					literal += '\n';	// Any control character, ignored
+					break;
+				case 'x':
+				{
+					char*	endPtr;
+					literal += (char)strtoul(inText.c_str() + i + 1, &endPtr, 16);
+					i = (endPtr - inText.c_str()) -1;
+					break;
+				}
+				default:
+					if (escChar >= '0' && escChar <= '7')
+					{
+						uint8_t	value = 0;
+						for (uint8_t digit = 0; digit < 3 &&
+							inText[i] >= '0' && inText[i] <= '7'; digit++, i++)
+						{
+							value = (value << 3) + inText[i] - '0';
+						}
+						i--;
+						literal += (char)value;
+					} else
+					{
+						literal += escChar;	// \\, \", \' and \?
+					}
+					break;
+			}
+		}
+		i++;
+		if (thisChar == '"' &&
+			!IsFMacro(inText, quote))
+		{
+			AddString(literal, ioCharcodes);
+		}
+	}
+}
+
+/********************************* ScanCSV ************************************/
+/*
+*	Adds the charcodes of the name field (the second field) of each location
+*	in a HikeLocations.csv.  The first line is the column names.
+*	Quotes are handled per CSV convention, same as CSVUtils::ReadStr.
+*/
+static void ScanCSV(
+	const std::string&	inText,
+	CharcodeSet&		ioCharcodes)
+{
+	std::string::size_type	length = inText.size();
+	std::string::size_type	i = inText.find('\n');
+	while (i != std::string::npos && i < length)
+	{
+		i++;
+		uint8_t		field = 0;
+		std::string	name;
+		bool	inQuote = false;
+		for (; i < length; i++)
+		{
+			char	thisChar = inText[i];
+			if (thisChar == '"')
+			{
+				if (inQuote && i+1 < length && inText[i+1] == '"')
+				{
+					i++;
+				} else
+				{
+					inQuote = !inQuote;
+					continue;
+				}
+			} else if (!inQuote)
+			{
+				if (thisChar == '\n')
+				{
+					break;
+				}
+				if (thisChar == ',')
+				{
+					field++;
+					continue;
+				}
+			}
+			if (field == 1)
+			{
+				name += thisChar;
+			}
+		}
+		AddString(name, ioCharcodes);
+	}
+}
+
+/******************************** ParseTable **********************************/
+/*
+*	Finds the initializer of inName within the font header text and returns
+*	the numbers within it.  Comments, including those between inName and the
+*	initializer, are skipped.  outEnd is set to the
+*	position following the initializer.
+*/
+static bool ParseTable(
+	const std::string&		inText,
+	const char*				inName,
+	std::vector<int32_t>&	outValues,
+	std::string::size_type*	outStart = nullptr,
+	std::string::size_type*	outEnd = nullptr)
+{
+	std::string::size_type	i = inText.find(inName);
+	bool	success = i != std::string::npos;
+	if (success)
+	{
+		if (outStart)
+		{
+			*outStart = inText.rfind("const", i);
+		}
+		uint8_t	depth = 0;
+		const char*	text = inText.c_str();
+		outValues.clear();
+		for (; text[i]; i++)
+		{
+			char	thisChar = text[i];
+			if (thisChar == '/' && text[i+1] == '/')
+			{
+				while (text[i+1] && text[i+1] != '\n')i++;
+			} else if (thisChar == '{')
+			{
+				depth++;
+			} else if (thisChar == '}')
+			{
+				depth--;
+				if (depth == 0)
+				{
+					i++;
+					break;
+				}
+			} else if (depth &&
+				(isdigit((uint8_t)thisChar) ||
+				(thisChar == '-' && isdigit((uint8_t)text[i+1]))))
+			{
+				char*	endPtr;
+				outValues.push_back((int32_t)strtol(&text[i], &endPtr, 0));
+				i = (endPtr - text) -1;
+			}
+		}
+		success = depth == 0 && text[i];
+		if (outEnd)
+		{
+			*outEnd = inText.find('\n', i);
+		}
+	}
+	if (!success)
+	{
+		fprintf(stderr, "Unable to parse %s\n", inName);
+	}
+	return(success);
+}
+
+/********************************* ParseFont **********************************/
+static bool ParseFont(
+	const char*		inPath,
+	SFontSource&	outFont)
+{
+	bool	success = ReadFile(inPath, outFont.text) &&
+		ParseTable(outFont.text, "fontHeader", outFont.header, &outFont.headerStart) &&
+		ParseTable(outFont.text, "charcodeRun[]", outFont.charcodeRuns) &&
+		ParseTable(outFont.text, "glyphDataOffset[]", outFont.glyphDataOffsets) &&
+		ParseTable(outFont.text, "glyphData[]", outFont.glyphData, nullptr, &outFont.tablesEnd);
+	if (success)
+	{
+		success = outFont.header.size() > eNumCharCodes &&
+			outFont.charcodeRuns.size() == (size_t)outFont.header[eNumCharcodeRuns]*2 &&
+			outFont.glyphDataOffsets.size() == (size_t)outFont.header[eNumCharCodes]+1 &&
+			outFont.glyphDataOffsets.back() == (int32_t)outFont.glyphData.size() &&
+			outFont.headerStart != std::string::npos &&
+			outFont.tablesEnd != std::string::npos;
+		if (!success)
+		{
+			fprintf(stderr, "%s is not a valid font header\n", inPath);
+		}
+	}
+	return(success);
+}
+
+/********************************* FindGlyph **********************************/
+/*
+*	Returns the entry index of inCharcode or -1 if the font doesn't contain
+*	inCharcode.
+*/
+static int32_t FindGlyph(
+	const SFontSource&	inFont,
+	uint16_t			inCharcode)
+{
+	int32_t	entryIndex = -1;
+	const std::vector<int32_t>&	runs = inFont.charcodeRuns;
+	for (size_t i = 0; i+2 < runs.size(); i += 2)
+	{
+		if (inCharcode >= runs[i] &&
+			inCharcode < (runs[i] + runs[i+3] - runs[i+1]))
+		{
+			entryIndex = runs[i+1] + inCharcode - runs[i];
+			break;
+		}
+	}
+	return(entryIndex);
+}
+
+/******************************** AppendUTF8 **********************************/
+static void AppendUTF8(
+	uint16_t		inCharcode,
+	std::string&	ioStr)
+{
+	if (inCharcode < 0x80)
+	{
+		ioStr += (char)inCharcode;
+	} else if (inCharcode < 0x800)
+	{
+		ioStr += (char)(0xC0 + (inCharcode >> 6));
+		ioStr += (char)(0x80 + (inCharcode & 0x3F));
+	} else
+	{
+		ioStr += (char)(0xE0 + (inCharcode >> 12));
+		ioStr += (char)(0x80 + ((inCharcode >> 6) & 0x3F));
+		ioStr += (char)(0x80 + (inCharcode & 0x3F));
+	}
+}
+
+/******************************** WriteTable **********************************/
+/*
+*	Writes inValues as hex, inPerLine per line, in the SubsetFontCreator
+*	layout.
+*/
+static void WriteTable(
+	FILE*						inFile,
+	const std::vector<int32_t>&	inValues,
+	const char*					inFormat,
+	uint8_t						inPerLine)
+{
+	for (size_t i = 0; i < inValues.size(); i++)
+	{
+		fprintf(inFile, (i % inPerLine) ? " " : "\t\t");
+		fprintf(inFile, inFormat, inValues[i]);
+		if (i+1 < inValues.size())
+		{
+			fprintf(inFile, ",");
+		}
+		if ((i % inPerLine) == (size_t)(inPerLine-1) ||
+			i+1 == inValues.size())
+		{
+			fprintf(inFile, "\n");
+		}
+	}
+}
+
+/********************************* WriteFont **********************************/
+static bool WriteFont(
+	const char*			inPath,
+	const SFontSource&	inFont,
+	const CharcodeSet&	inCharcodes)
+{
+	/*
+	*	Build the subset's tables.  A run is added for each range of
+	*	consecutive charcodes.
+	*/
+	std::vector<int32_t>	charcodeRuns;
+	std::vector<int32_t>	glyphDataOffsets;
+	std::vector<int32_t>	glyphData;
+	std::string				rangeStr;
+	int32_t		width = 0;
+	int32_t		prevCharcode = -2;
+	for (CharcodeSet::const_iterator itr = inCharcodes.begin();
+						itr != inCharcodes.end(); ++itr)
+	{
+		uint16_t	charcode = *itr;
+		int32_t		entryIndex = FindGlyph(inFont, charcode);
+		int32_t		start = inFont.glyphDataOffsets[entryIndex];
+		int32_t		end = inFont.glyphDataOffsets[entryIndex+1];
+		if (charcode != prevCharcode+1)
+		{
+			if (rangeStr.size())
+			{
+				AppendUTF8(prevCharcode, rangeStr);
+			}
+			AppendUTF8(charcode, rangeStr);
+			charcodeRuns.push_back(charcode);
+			charcodeRuns.push_back((int32_t)glyphDataOffsets.size());
+		}
+		prevCharcode = charcode;
+		glyphDataOffsets.push_back((int32_t)glyphData.size());
+		glyphData.insert(glyphData.end(), inFont.glyphData.begin() + start,
+											inFont.glyphData.begin() + end);
+		// The first field of the GlyphHeader is advanceX.
+		if (inFont.glyphData[start] > width)
+		{
+			width = inFont.glyphData[start];
+		}
+	}
+	if (rangeStr.size())
+	{
+		AppendUTF8(prevCharcode, rangeStr);
+	}
+	int32_t	numCharCodes = (int32_t)glyphDataOffsets.size();
+	charcodeRuns.push_back(0xFFFF);
+	charcodeRuns.push_back(numCharCodes);
+	glyphDataOffsets.push_back((int32_t)glyphData.size());
+	bool	success = glyphData.size() <= 0xFFFF;
+	if (!success)
+	{
+		fprintf(stderr, "The glyph data exceeds 64KB\n");
+	}
+	FILE*	file = stdout;
+	if (success &&
+		inPath)
+	{
+		file = fopen(inPath, "w");
+		success = file != nullptr;
+		if (!success)
+		{
+			fprintf(stderr, "Unable to create %s\n", inPath);
+		}
+	}
+	if (success)
+	{
+		const std::vector<int32_t>&	header = inFont.header;
+		fprintf(file, "// Subset font created by XFontSubset\n");
+		fprintf(file, "// For subset: \"%s\"\n", rangeStr.c_str());
+		/*
+		*	Copy everything between the original comments and the
+		*	fontHeader (the include guard, includes and namespace) as is.
+		*/
+		std::string::size_type	guardStart = inFont.text.find("#ifndef");
+		if (guardStart == std::string::npos ||
+			guardStart > inFont.headerStart)
+		{
+			guardStart = inFont.headerStart;
+		}
+		fprintf(file, "\n%s", inFont.text.substr(guardStart, inFont.headerStart - guardStart).c_str());
+		fprintf(file, "const FontHeader	fontHeader PROGMEM =\n\t{\n");
+		fprintf(file, "\t\t%d,\t\t// version, currently version = 1\n", header[eVersion]);
+		fprintf(file, "\t\t%d,\t\t// oneBit, 1 = 1 bit per pixel, 0 = 8 bit (antialiased)\n", header[eOneBit]);
+		fprintf(file, "\t\t%d,\t\t// rotated, glyph data is rotated (applies to 1 bit only)\n", header[eRotated]);
+		fprintf(file, "\t\t%d,\t\t// horizontal, addressing for rotated data, else vertical\n", header[eHorizontal]);
+		fprintf(file, "\t\t%d,\t\t// monospaced, fixed width font (for this subset)\n", header[eMonospaced]);
+		fprintf(file, "\t\t%d,\t\t// ascent, font in pixels\n", header[eAscent]);
+		fprintf(file, "\t\t%d,\t\t// descent, font in pixels\n", header[eDescent]);
+		fprintf(file, "\t\t%d,\t\t// height, font height (ascent+descent+leading) in pixels\n", header[eHeight]);
+		fprintf(file, "\t\t%d,\t\t// width, widest glyph advanceX within subset in pixels\n", width);
+		fprintf(file, "\t\t%d,\t\t// numCharcodeRuns\n", (int)charcodeRuns.size()/2);
+		/*
+		*	runLength1Bit is written even when the original font predates the
+		*	field, so that the header is fully initialized
+		*	(-Wmissing-field-initializers.)
+		*/
+		fprintf(file, "\t\t%d,\t\t// numCharCodes\n", numCharCodes);
+		fprintf(file, "\t\t%d\t\t// runLength1Bit, 1 bit data is run length encoded\n",
+			header.size() > eRunLength1Bit ? header[eRunLength1Bit] : 0);
+		fprintf(file, "\t};\n\t\n");
+		fprintf(file, "\tconst CharcodeRun	charcodeRun[] PROGMEM = // {start, entryIndex}, ...\n\t{\n");
+		for (size_t i = 0; i < charcodeRuns.size(); i += 2)
+		{
+			fprintf(file, (i % 10) ? " " : "\t\t");
+			fprintf(file, "{0x%04X, %d}", charcodeRuns[i], charcodeRuns[i+1]);
+			if (i+2 < charcodeRuns.size())
+			{
+				fprintf(file, ",");
+			}
+			if ((i % 10) == 8 ||
+				i+2 == charcodeRuns.size())
+			{
+				fprintf(file, "\n");
+			}
+		}
+		fprintf(file, "\t};\n\t\n");
+		fprintf(file, "\tconst uint16_t	glyphDataOffset[] PROGMEM =\n\t{\n");
+		WriteTable(file, glyphDataOffsets, "0x%04X", 8);
+		fprintf(file, "\t};\n\t\n");
+		fprintf(file, "\tconst uint8_t	glyphData[] PROGMEM =\n\t{\n");
+		WriteTable(file, glyphData, "0x%02X", 12);
+		fprintf(file, "\t};");
+		// Copy the rest of the original (usage comments and the Font) as is.
+		fprintf(file, "%s", inFont.text.substr(inFont.tablesEnd).c_str());
+		if (file != stdout)
+		{
+			fclose(file);
+		}
+		fprintf(stderr, "%d glyphs, %d runs, %d bytes of glyph data (was %d glyphs, %d runs, %d bytes)\n",
+			numCharCodes, (int)charcodeRuns.size()/2, (int)glyphData.size(),
+			header[eNumCharCodes], header[eNumCharcodeRuns], (int)inFont.glyphData.size());
+	}
+	return(success);
+}
+
+/************************************ main ************************************/
+int main(
+	int		argc,
+	char*	argv[])
+{
+	const char*	fontPath = nullptr;
+	const char*	outPath = nullptr;
+	CharcodeSet	charcodes;
+	bool	success = true;
+	for (int i = 1; success && i < argc; i++)
+	{
+		const char*	arg = argv[i];
+		if (arg[0] == '-' && arg[1] && !arg[2] && i+1 < argc)
+		{
+			const char*	value = argv[++i];
+			switch (arg[1])
+			{
+				case 'f':
+					fontPath = value;
+					break;
+				case 'o':
+					outPath = value;
+					break;
+				case 'r':
+					success = AddRange(value, charcodes);
+					break;
+				case 'c':
+				{
+					std::string	text;
+					success = ReadFile(value, text);
+					if (success)
+					{
+						ScanCSV(text, charcodes);
+					}
+					break;
+				}
+				default:
+					success = false;
+					break;
+			}
+		} else if (arg[0] != '-')
+		{
+			std::string	text;
+			success = ReadFile(arg, text);
+			if (success)
+			{
+				ScanSource(text, charcodes);
+			}
+		} else
+		{
+			success = false;
+		}
+	}
+	SFontSource	font;
+	success = success && fontPath && ParseFont(fontPath, font);
+	if (success)
+	{
+		/*
+		*	Remove the charcodes the font doesn't contain.
+		*/
+		for (CharcodeSet::iterator itr = charcodes.begin(); itr != charcodes.end();)
+		{
+			if (FindGlyph(font, *itr) < 0)
+			{
+				std::string	charStr;
+				AppendUTF8(*itr, charStr);
+				fprintf(stderr, "Not in font: U+%04X \"%s\"\n", *itr, charStr.c_str());
+				itr = charcodes.erase(itr);
+			} else
+			{
+				++itr;
+			}
+		}
+		success = charcodes.size() > 0;
+		if (success)
+		{
+			success = WriteFont(outPath, font, charcodes);
+		} else
+		{
+			fprintf(stderr, "No charcodes used\n");
+		}
+	} else
+	{
+		fprintf(stderr, "Usage: XFontSubset -f font.h [-o out.h] [-c locations.csv] [-r range] [source files...]\n");
+	}
+	return(success ? 0 : 1);
+}
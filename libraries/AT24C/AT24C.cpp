@@ -21,38 +21,49 @@
 *
 */
 
+#if !defined(__MACH__) && !defined(__linux__)
 #include "Arduino.h"
 #include "AT24C.h"
 #include <Wire.h>
+#else
+#include "AT24C.h"
+#endif
 
 /*********************************** AT24C ************************************/
 AT24C::AT24C(
 	uint8_t	inDeviceAddress,
 	uint8_t	inCapacity)
-	: mDeviceAddress(inDeviceAddress)
+	: mDeviceAddress(inDeviceAddress), mPageSize(PageSize(inCapacity))
 #ifdef DEBUG_AT24C
 		, mMaxWaitTime(0)
 #endif
+#if defined(__MACH__) || defined(__linux__)
+		, mSim(inCapacity, mPageSize)
+#endif
+{
+#if defined(__MACH__) || defined(__linux__)
+	Wire.AttachDevice(inDeviceAddress, &mSim);
+#endif
+}
+
+/********************************** PageSize **********************************/
+uint16_t AT24C::PageSize(
+	uint8_t	inCapacity)
 {
 	switch(inCapacity)
 	{
 		case 4:		// C32
 		case 8:		// C64
-			mPageSize = 32;
-			break;
+			return(32);
 		case 16:	// C128
 		case 32:	// C256
-			mPageSize = 64;
-			break;
+			return(64);
 		case 64:	// C512
-			mPageSize = 128;
-			break;
+			return(128);
 		case 128:	// C1024
-			mPageSize = 256;
-			break;
+			return(256);
 		default:
-			mPageSize = 32;
-			break;
+			return(32);
 	}
 }
 
@@ -24,6 +24,10 @@
 #ifndef AT24C_H
 #define AT24C_H
 
+#if defined(__MACH__) || defined(__linux__)
+#include "AT24CSim.h"
+#endif
+
 // AT24C01A -> C16A aren't supported
 // Only tested with C32, C128, and C256 (32, 64 and 64 byte pages resp.)
 #define DEBUG_AT24C 1
@@ -51,10 +55,23 @@ public:
 								{return(mMaxWaitTime);}
 	uint32_t mMaxWaitTime;
 #endif
+#if defined(__MACH__) || defined(__linux__)
+	/*
+	*	On the host the chip is simulated.  Simulated bus time is available
+	*	via Wire.BusTime().
+	*/
+	AT24CSim&				Sim(void)
+								{return(mSim);}
+#endif
 private:
+	static uint16_t			PageSize(
+								uint8_t					inCapacity);
 	uint8_t		mDeviceAddress;	// 0x50 + N low address bits.
 								// 3 bits for C32 -> C64, 2 bits for C128 -> C512
 	uint16_t	mPageSize;		// Initialized to one of: 32, 64, 128
+#if defined(__MACH__) || defined(__linux__)
+	AT24CSim	mSim;
+#endif
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,144 @@
+/*
+*	AT24CSim.cpp, Copyright Jonathan Mackey 2023
+*	Host (desktop) simulation of an AT24C family chip on the simulated Wire
+*	bus.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#if defined(__MACH__) || defined(__linux__)
+#include "AT24CSim.h"
+#include <string.h>
+
+/********************************** AT24CSim **********************************/
+AT24CSim::AT24CSim(
+	uint8_t		inCapacity,
+	uint16_t	inPageSize)
+	: mBusyUntil(0), mWriteCycleTime(5000000), mSize((uint32_t)inCapacity * 1024),
+	  mAddress(0), mPageSize(inPageSize)
+{
+	mMemory = new uint8_t[mSize];
+	memset(mMemory, 0xFF, mSize);	// Erased state
+	mPageWrites = new uint32_t[NumPages()];
+	ResetStats();
+}
+
+/********************************* ~AT24CSim **********************************/
+AT24CSim::~AT24CSim(void)
+{
+	delete [] mMemory;
+	delete [] mPageWrites;
+}
+
+/********************************* ResetStats *********************************/
+void AT24CSim::ResetStats(void)
+{
+	memset(mPageWrites, 0, NumPages() * sizeof(uint32_t));
+	mWriteCycles = 0;
+	mBytesWritten = 0;
+	mBytesRead = 0;
+}
+
+/***************************** MaxPageWriteCount ******************************/
+uint32_t AT24CSim::MaxPageWriteCount(void) const
+{
+	uint32_t	maxCount = 0;
+	for (uint16_t page = NumPages(); page; page--)
+	{
+		if (mPageWrites[page-1] > maxCount)
+		{
+			maxCount = mPageWrites[page-1];
+		}
+	}
+	return(maxCount);
+}
+
+/********************************* WornPages **********************************/
+uint16_t AT24CSim::WornPages(void) const
+{
+	uint16_t	wornPages = 0;
+	for (uint16_t page = NumPages(); page; page--)
+	{
+		if (mPageWrites[page-1] >= kEndurance)
+		{
+			wornPages++;
+		}
+	}
+	return(wornPages);
+}
+
+/******************************** Acknowledge *********************************/
+bool AT24CSim::Acknowledge(
+	uint64_t	inBusTime)
+{
+	return(inBusTime >= mBusyUntil);
+}
+
+/********************************** Receive ***********************************/
+void AT24CSim::Receive(
+	const uint8_t*	inData,
+	uint8_t			inLength,
+	uint64_t		inBusTime)
+{
+	if (inLength >= 2)
+	{
+		/*
+		*	The driver only sends a 16 bit data address.  On the 128KB part
+		*	(AT24C1024) A16 is a device address bit, which isn't modeled.
+		*/
+		mAddress = (((uint32_t)inData[0] << 8) | inData[1]) % mSize;
+		inData += 2;
+		inLength -= 2;
+		if (inLength)
+		{
+			/*
+			*	The low address bits roll over within the page, the high bits
+			*	(the page) stay fixed.
+			*/
+			uint32_t	pageMask = mPageSize -1;
+			uint32_t	pageAddr = mAddress & ~pageMask;
+			uint32_t	offset = mAddress & pageMask;
+			for (uint8_t i = 0; i < inLength; i++)
+			{
+				mMemory[pageAddr + offset] = inData[i];
+				offset = (offset + 1) & pageMask;
+			}
+			mAddress = pageAddr + offset;
+			mPageWrites[pageAddr/mPageSize]++;
+			mWriteCycles++;
+			mBytesWritten += inLength;
+			mBusyUntil = inBusTime + mWriteCycleTime;
+		}
+	}
+}
+
+/********************************** Transmit **********************************/
+uint8_t AT24CSim::Transmit(
+	uint8_t		inLength,
+	uint8_t*	outData,
+	uint64_t	inBusTime)
+{
+	for (uint8_t i = 0; i < inLength; i++)
+	{
+		outData[i] = mMemory[mAddress];
+		mAddress = (mAddress + 1) % mSize;
+	}
+	mBytesRead += inLength;
+	return(inLength);
+}
+#endif // __MACH__ || __linux__
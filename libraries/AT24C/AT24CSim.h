@@ -0,0 +1,108 @@
+/*
+*	AT24CSim.h, Copyright Jonathan Mackey 2023
+*	Host (desktop) simulation of an AT24C family chip on the simulated Wire
+*	bus.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef AT24CSim_h
+#define AT24CSim_h
+
+#if defined(__MACH__) || defined(__linux__)
+#include "WireSim.h"
+
+/*
+*	Models the parts of the chip that matter when benchmarking the storage
+*	code:
+*	- The first 2 bytes of a write transmission set the address pointer.  If
+*	  no data follows (a dummy write), no write cycle is started.
+*	- Data written wraps within the current page, as it does on the chip.
+*	- The stop after a data write starts a write cycle.  The chip NACKs its
+*	  address until the write cycle time has elapsed.
+*	- Sequential reads wrap at the end of memory.
+*	- Every write cycle increments the write count of the page written.  The
+*	  wear of the most written page is reported relative to the rated
+*	  endurance (kEndurance.)
+*/
+class AT24CSim : public WireSimDevice
+{
+public:
+	static const uint32_t	kEndurance = 1000000;	// Write cycles per page
+							AT24CSim(
+								uint8_t					inCapacity,	// KB
+								uint16_t				inPageSize);
+	virtual					~AT24CSim(void);
+	virtual bool			Acknowledge(
+								uint64_t				inBusTime);
+	virtual void			Receive(
+								const uint8_t*			inData,
+								uint8_t					inLength,
+								uint64_t				inBusTime);
+	virtual uint8_t			Transmit(
+								uint8_t					inLength,
+								uint8_t*				outData,
+								uint64_t				inBusTime);
+	/*
+	*	tWR, defaults to the 5ms datasheet maximum.
+	*/
+	void					SetWriteCycleTime(
+								uint32_t				inMicroseconds)
+								{mWriteCycleTime = (uint64_t)inMicroseconds * 1000;}
+	uint8_t*				Memory(void)
+								{return(mMemory);}
+	uint32_t				Size(void) const
+								{return(mSize);}
+	uint16_t				NumPages(void) const
+								{return(mSize/mPageSize);}
+	uint32_t				PageWriteCount(
+								uint16_t				inPage) const
+								{return(inPage < NumPages() ? mPageWrites[inPage] : 0);}
+	uint32_t				MaxPageWriteCount(void) const;
+	/*
+	*	Percent of kEndurance used by the most written page since the last
+	*	ResetStats.
+	*/
+	double					EndurancePercentUsed(void) const
+								{return(MaxPageWriteCount() * 100.0 / kEndurance);}
+	/*
+	*	The number of pages written kEndurance or more times.
+	*/
+	uint16_t				WornPages(void) const;
+	uint32_t				WriteCycles(void) const
+								{return(mWriteCycles);}
+	uint32_t				BytesWritten(void) const
+								{return(mBytesWritten);}
+	uint32_t				BytesRead(void) const
+								{return(mBytesRead);}
+	void					ResetStats(void);
+protected:
+	uint8_t*	mMemory;
+	uint32_t*	mPageWrites;
+	uint64_t	mBusyUntil;
+	uint64_t	mWriteCycleTime;	// ns
+	uint32_t	mSize;
+	uint32_t	mWriteCycles;
+	uint32_t	mBytesWritten;
+	uint32_t	mBytesRead;
+	uint32_t	mAddress;
+	uint16_t	mPageSize;
+};
+
+#endif // __MACH__ || __linux__
+#endif // AT24CSim_h
@@ -0,0 +1,63 @@
+/*
+*	CRC16.cpp, Copyright Jonathan Mackey 2023
+*	CRC-16/CCITT (polynomial 0x1021, initial value 0xFFFF)
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#include "CRC16.h"
+#ifdef __MACH__
+#include "pgmspace_stub.h"
+#else
+	#include <Arduino.h>
+	#ifdef ESP_H
+		#include <pgmspace.h>
+	#else
+		#include <avr/pgmspace.h>
+	#endif
+#endif
+
+// kNibbleTable[n] = n * 0x1021 (i.e. the CRC of the nibble n << 12)
+const uint16_t kNibbleTable[] PROGMEM =
+{
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/*********************************** Update ***********************************/
+uint16_t CRC16::Update(
+	uint16_t	inCRC,
+	uint8_t		inByte)
+{
+	inCRC = (inCRC << 4) ^ pgm_read_word_near(&kNibbleTable[(inCRC >> 12) ^ (inByte >> 4)]);
+	return((inCRC << 4) ^ pgm_read_word_near(&kNibbleTable[(inCRC >> 12) ^ (inByte & 0x0F)]));
+}
+
+/************************************ Calc ************************************/
+uint16_t CRC16::Calc(
+	const void*	inData,
+	uint32_t	inLength,
+	uint16_t	inCRC)
+{
+	const uint8_t*	data = (const uint8_t*)inData;
+	for (; inLength; inLength--)
+	{
+		inCRC = Update(inCRC, *(data++));
+	}
+	return(inCRC);
+}
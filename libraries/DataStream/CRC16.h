@@ -0,0 +1,45 @@
+/*
+*	CRC16.h, Copyright Jonathan Mackey 2023
+*	CRC-16/CCITT (polynomial 0x1021, initial value 0xFFFF)
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef CRC16_h
+#define CRC16_h
+
+#include <inttypes.h>
+
+/*
+*	A nibble table is used rather than a 256 entry byte table.  The table is
+*	32 bytes of PROGMEM and costs two table lookups per byte.
+*	CRC16::Calc("123456789", 9) = 0x29B1
+*/
+class CRC16
+{
+public:
+	static const uint16_t	kInitialValue = 0xFFFF;
+	static uint16_t			Update(
+								uint16_t				inCRC,
+								uint8_t					inByte);
+	static uint16_t			Calc(
+								const void*				inData,
+								uint32_t				inLength,
+								uint16_t				inCRC = kInitialValue);
+};
+#endif // CRC16_h
@@ -21,6 +21,7 @@
 *
 */
 #include "DataStream.h"
+#include "CRC16.h"
 #ifdef __MACH__
 #include "pgmspace_stub.h"
 #else
@@ -34,6 +35,75 @@
 #endif
 #include <string.h>
 
+/********************************** ReadCRC ***********************************/
+bool DataStream::ReadCRC(
+	uint32_t	inLength,
+	void*		outBuffer)
+{
+	uint16_t	crc;
+	return(Read(inLength, outBuffer) == inLength &&
+		Read(sizeof(uint16_t), &crc) == sizeof(uint16_t) &&
+		CRC16::Calc(outBuffer, inLength) == crc);
+}
+
+/********************************** WriteCRC **********************************/
+bool DataStream::WriteCRC(
+	uint32_t	inLength,
+	const void*	inBuffer)
+{
+	uint16_t	crc = CRC16::Calc(inBuffer, inLength);
+	return(Write(inLength, inBuffer) == inLength &&
+		Write(sizeof(uint16_t), &crc) == sizeof(uint16_t));
+}
+
+/********************************* VerifyCRC **********************************/
+uint16_t DataStream::VerifyCRC(
+	uint32_t	inRecordLength,
+	uint16_t	inCount)
+{
+	uint8_t		buffer[32];
+	uint16_t	failures = 0;
+	for (; inCount; inCount--)
+	{
+		uint16_t	crc = CRC16::kInitialValue;
+		uint32_t	bytesLeft = inRecordLength;
+		while (bytesLeft)
+		{
+			uint32_t	bytes2Read = bytesLeft > sizeof(buffer) ? sizeof(buffer) : bytesLeft;
+			if (Read(bytes2Read, buffer) != bytes2Read)
+			{
+				return(failures + inCount);
+			}
+			crc = CRC16::Calc(buffer, bytes2Read, crc);
+			bytesLeft -= bytes2Read;
+		}
+		uint16_t	recordCRC;
+		if (Read(sizeof(uint16_t), &recordCRC) != sizeof(uint16_t))
+		{
+			return(failures + inCount);
+		}
+		if (recordCRC != crc)
+		{
+			failures++;
+		}
+	}
+	return(failures);
+}
+
+/************************************ Map *************************************/
+/*
+*	The default Map for streams that can't be directly addressed.
+*/
+const void* DataStream::Map(
+	uint32_t	inLength,
+	void*		ioBuffer,
+	uint8_t&	outAddressSpace)
+{
+	outAddressSpace = eSRAM;
+	return((Clip(inLength) == inLength &&
+		Read(inLength, ioBuffer) == inLength) ? ioBuffer : nullptr);
+}
+
 /******************************* DataStreamImpl *******************************/
 DataStreamImpl::DataStreamImpl(
 	const void*	inStartAddress,
@@ -91,6 +161,18 @@ uint32_t DataStreamImpl::Clip(
 	return((mCurrent + inLength) <= mEndAddr ? inLength : (uint32_t)(mEndAddr - mCurrent));
 }
 
+/********************************* MapInPlace *********************************/
+const void* DataStreamImpl::MapInPlace(
+	uint32_t	inLength)
+{
+	const void*	mappedData = nullptr;
+	if (Clip(inLength) == inLength)
+	{
+		mappedData = mCurrent;
+		mCurrent += inLength;
+	}
+	return(mappedData);
+}
 
 /****************************** DataStream_S *******************************/
 DataStream_S::DataStream_S(
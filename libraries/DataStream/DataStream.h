@@ -36,6 +36,11 @@ public:
 		eSeekCur,
 		eSeekEnd
 	};
+	enum EAddressSpace
+	{
+		eSRAM,
+		ePROGMEM
+	};
 
 	virtual uint32_t		Read(
 								uint32_t				inLength,
@@ -50,6 +55,38 @@ public:
 	virtual bool			AtEOF(void) const = 0;
 	virtual uint32_t		Clip(
 								uint32_t				inLength) const = 0;	
+	/*
+	*	Map returns a pointer to the next inLength bytes and advances the
+	*	stream the same as Read.  When the stream's data is directly
+	*	addressable the pointer is into the stream's storage and nothing is
+	*	copied.  Otherwise the data is read into ioBuffer (at least inLength
+	*	bytes) and ioBuffer is returned.  outAddressSpace is set to one of
+	*	EAddressSpace for the returned pointer.  Returns nullptr if less than
+	*	inLength bytes remain.
+	*/
+	virtual const void*		Map(
+								uint32_t				inLength,
+								void*					ioBuffer,
+								uint8_t&				outAddressSpace);
+	/*
+	*	CRC protected records.  On the stream a record is followed by its
+	*	CRC16 (see CRC16.h.)  ReadCRC returns false if the record couldn't be
+	*	read or its CRC doesn't match.
+	*/
+	bool					ReadCRC(
+								uint32_t				inLength,
+								void*					outBuffer);
+	bool					WriteCRC(
+								uint32_t				inLength,
+								const void*				inBuffer);
+	/*
+	*	Verifies inCount consecutive CRC records starting at the current
+	*	position in a single pass.  inRecordLength doesn't include the CRC.
+	*	Returns the number of records that failed.
+	*/
+	uint16_t				VerifyCRC(
+								uint32_t				inRecordLength,
+								uint16_t				inCount);
 };
 
 class DataStreamImpl : public DataStream
@@ -68,6 +105,9 @@ public:
 								uint32_t				inLength) const;
 
 protected:
+	const void*				MapInPlace(
+								uint32_t				inLength);
+
 	const uint8_t*	mStartAddr;
 	const uint8_t*	mCurrent;
 	const uint8_t*	mEndAddr;
@@ -87,6 +127,12 @@ public:
 	virtual uint32_t		Write(
 								uint32_t				inLength,
 								const void*				inBuffer);
+	virtual const void*		Map(
+								uint32_t				inLength,
+								void*					ioBuffer,
+								uint8_t&				outAddressSpace)
+								{outAddressSpace = eSRAM;
+									return(MapInPlace(inLength));}
 
 };
 
@@ -103,6 +149,12 @@ public:
 	virtual uint32_t		Write(
 								uint32_t				inLength,
 								const void*				inBuffer);
+	virtual const void*		Map(
+								uint32_t				inLength,
+								void*					ioBuffer,
+								uint8_t&				outAddressSpace)
+								{outAddressSpace = ePROGMEM;
+									return(MapInPlace(inLength));}
 
 };
 
@@ -34,8 +34,14 @@ DisplayController::DisplayController(
 	uint16_t	inRows,
 	uint16_t	inColumns)
 	: mRows(inRows), mColumns(inColumns), mRow(0), mColumn(0),
-	  mAddressingMode(eHorizontal), mFGColor(0xFFFF), mBGColor(0)
+	  mAddressingMode(eHorizontal), mFGColor(0xFFFF), mBGColor(0),
+	  mScrollFirstRow(0), mScrollRows(0), mScrollOffset(0)
 {
+#if DISPLAY_DAMAGE_RECTS
+	mFrameOpen = false;
+	mDamageCount = 0;
+	mCover.width = 0;
+#endif
 }
 
 /********************************* CanMoveTo **********************************/
@@ -90,6 +96,24 @@ void DisplayController::MoveRowBy(
 	MoveToRow(newRow);
 }
 
+/******************************** ScrolledRow *********************************/
+uint16_t DisplayController::ScrolledRow(
+	uint16_t	inRow) const
+{
+	uint16_t	areaRow = inRow - mScrollFirstRow;
+	if (inRow >= mScrollFirstRow &&
+		areaRow < mScrollRows)
+	{
+		areaRow += mScrollOffset;
+		if (areaRow >= mScrollRows)
+		{
+			areaRow -= mScrollRows;
+		}
+		inRow = mScrollFirstRow + areaRow;
+	}
+	return(inRow);
+}
+
 /********************************** WillFit ***********************************/
 bool DisplayController::WillFit(
 	uint16_t	inRows,
@@ -166,6 +190,9 @@ void DisplayController::Fill(
 	*	writing mode command is terminated before the fill starts.
 	*	The order doesn't matter on the OLED display.
 	*/
+#if DISPLAY_DAMAGE_RECTS
+	mDamageCount = 0;	// Everything is covered
+#endif
 	MoveTo(0, 0);	// After clear the page and column will wrap to zero (no need to call MoveTo again at end.)
 	SetColumnRange(0, mColumns-1);	// Reset the range in case it's been clipped.
 	FillPixels((uint32_t)mRows*mColumns, inFillColor);
@@ -187,6 +214,7 @@ void DisplayController::FillBlock(
 	}
 	if (inColumns && inRows)
 	{
+		Cover(mRow, mColumn, inRows, inColumns);
 		SetColumnRange(inColumns);
 		// The column index will wrap back to the starting point.
 		// The page won't so it needs to be reset.
@@ -263,6 +291,280 @@ uint16_t DisplayController::DrawRoundedRect(
 	return(fillColor);
 }
 
+/********************************* EraseBlock *********************************/
+void DisplayController::EraseBlock(
+	uint16_t	inRows,
+	uint16_t	inColumns)
+{
+#if DISPLAY_DAMAGE_RECTS
+	if (mFrameOpen)
+	{
+		if ((inColumns+mColumn) >= mColumns)
+		{
+			inColumns = mColumns - mColumn;
+		}
+		if ((inRows+mRow) >= mRows)
+		{
+			inRows = mRows - mRow;
+		}
+		if (inColumns && inRows)
+		{
+			/*
+			*	Anything covered before this erase is applied first so that it
+			*	doesn't remove the new damage.
+			*/
+			ApplyCover();
+			Rect16_t	rect;
+			rect.x = mColumn;
+			rect.y = mRow;
+			rect.width = inColumns;
+			rect.height = inRows;
+			AddDamage(rect, true);
+			MoveColumnBy(inColumns);
+		}
+	} else
+#endif
+	{
+		FillBlock(inRows, inColumns, mBGColor);
+	}
+}
+
+/********************************* BeginFrame *********************************/
+void DisplayController::BeginFrame(void)
+{
+#if DISPLAY_DAMAGE_RECTS
+	mFrameOpen = true;
+#endif
+}
+
+/********************************** EndFrame **********************************/
+void DisplayController::EndFrame(void)
+{
+#if DISPLAY_DAMAGE_RECTS
+	FlushDamage();
+	mFrameOpen = false;
+#endif
+}
+
+/******************************** FlushDamage *********************************/
+void DisplayController::FlushDamage(void)
+{
+#if DISPLAY_DAMAGE_RECTS
+	if (mDamageCount)
+	{
+		ApplyCover();
+		while (mDamageCount)
+		{
+			mDamageCount--;
+			EraseRect16(mDamage[mDamageCount]);
+		}
+	}
+#endif
+}
+
+#if DISPLAY_DAMAGE_RECTS
+/********************************** AddCover **********************************/
+/*
+*	Consecutive covers are coalesced while they form a rectangle.  A glyph is
+*	drawn as several blocks (the margins and the glyph itself), so without
+*	this each block would split the damage it lands on.
+*/
+void DisplayController::AddCover(
+	uint16_t	inRow,
+	uint16_t	inColumn,
+	uint16_t	inRows,
+	uint16_t	inColumns)
+{
+	if (mCover.width &&
+		mCover.y == inRow &&
+		mCover.height == inRows &&
+		(mCover.x + mCover.width) == inColumn)
+	{
+		mCover.width += inColumns;
+	} else if (mCover.width &&
+		mCover.x == inColumn &&
+		mCover.width == inColumns &&
+		(mCover.y + mCover.height) == inRow)
+	{
+		mCover.height += inRows;
+	} else
+	{
+		ApplyCover();
+		mCover.x = inColumn;
+		mCover.y = inRow;
+		mCover.width = inColumns;
+		mCover.height = inRows;
+	}
+}
+
+/********************************* ApplyCover *********************************/
+/*
+*	Removes the pending cover from the damage.  A damaged rectangle that
+*	intersects the cover is replaced by up to 4 rectangles: the parts above
+*	and below the cover, and the parts to its left and right.
+*/
+void DisplayController::ApplyCover(void)
+{
+	if (mCover.width && mCover.height)
+	{
+		uint16_t	coverRight = mCover.x + mCover.width;
+		uint16_t	coverBottom = mCover.y + mCover.height;
+		/*
+		*	Pieces are added at the end of the list so walking the list
+		*	backwards doesn't revisit them.
+		*/
+		for (uint8_t i = mDamageCount; i;)
+		{
+			i--;
+			Rect16_t	damage = mDamage[i];
+			uint16_t	damageRight = damage.x + damage.width;
+			uint16_t	damageBottom = damage.y + damage.height;
+			if (mCover.x < damageRight &&
+				damage.x < coverRight &&
+				mCover.y < damageBottom &&
+				damage.y < coverBottom)
+			{
+				RemoveDamage(i);
+				Rect16_t	piece;
+				if (damage.y < mCover.y)
+				{
+					piece.x = damage.x;
+					piece.y = damage.y;
+					piece.width = damage.width;
+					piece.height = mCover.y - damage.y;
+					AddDamage(piece, false);
+				}
+				if (coverBottom < damageBottom)
+				{
+					piece.x = damage.x;
+					piece.y = coverBottom;
+					piece.width = damage.width;
+					piece.height = damageBottom - coverBottom;
+					AddDamage(piece, false);
+				}
+				piece.y = damage.y > mCover.y ? damage.y : mCover.y;
+				piece.height = (damageBottom < coverBottom ? damageBottom : coverBottom) - piece.y;
+				if (damage.x < mCover.x)
+				{
+					piece.x = damage.x;
+					piece.width = mCover.x - damage.x;
+					AddDamage(piece, false);
+				}
+				if (coverRight < damageRight)
+				{
+					piece.x = coverRight;
+					piece.width = damageRight - coverRight;
+					AddDamage(piece, false);
+				}
+			}
+		}
+	}
+	mCover.width = 0;
+}
+
+/********************************* AddDamage **********************************/
+/*
+*	When inMerge is true, inRect is merged with any damaged rectangle it
+*	overlaps or abuts when the union is also a rectangle.  If the list is full
+*	inRect is erased now.  This is safe because the damage never includes an
+*	area drawn over within the frame.
+*/
+void DisplayController::AddDamage(
+	const Rect16_t&	inRect,
+	bool			inMerge)
+{
+	Rect16_t	rect = inRect;
+	if (inMerge)
+	{
+		for (uint8_t i = 0; i < mDamageCount;)
+		{
+			const Rect16_t&	damage = mDamage[i];
+			uint16_t	damageRight = damage.x + damage.width;
+			uint16_t	damageBottom = damage.y + damage.height;
+			uint16_t	rectRight = rect.x + rect.width;
+			uint16_t	rectBottom = rect.y + rect.height;
+			bool	merged = true;
+			if (damage.x <= rect.x &&
+				damage.y <= rect.y &&
+				damageRight >= rectRight &&
+				damageBottom >= rectBottom)
+			{
+				return;	// Already damaged
+			} else if (rect.x <= damage.x &&
+				rect.y <= damage.y &&
+				rectRight >= damageRight &&
+				rectBottom >= damageBottom)
+			{
+				// rect contains damage, damage is simply removed
+			} else if (damage.x == rect.x &&
+				damage.width == rect.width &&
+				rect.y <= damageBottom &&
+				damage.y <= rectBottom)
+			{
+				if (damage.y < rect.y)
+				{
+					rect.y = damage.y;
+				}
+				rect.height = (damageBottom > rectBottom ? damageBottom : rectBottom) - rect.y;
+			} else if (damage.y == rect.y &&
+				damage.height == rect.height &&
+				rect.x <= damageRight &&
+				damage.x <= rectRight)
+			{
+				if (damage.x < rect.x)
+				{
+					rect.x = damage.x;
+				}
+				rect.width = (damageRight > rectRight ? damageRight : rectRight) - rect.x;
+			} else
+			{
+				merged = false;
+			}
+			if (merged)
+			{
+				RemoveDamage(i);
+				i = 0;	// The union may now merge with a rectangle already passed
+			} else
+			{
+				i++;
+			}
+		}
+	}
+	if (mDamageCount < DISPLAY_DAMAGE_RECTS)
+	{
+		mDamage[mDamageCount] = rect;
+		mDamageCount++;
+	} else
+	{
+		EraseRect16(rect);
+	}
+}
+
+/******************************** RemoveDamage ********************************/
+void DisplayController::RemoveDamage(
+	uint8_t	inIndex)
+{
+	mDamageCount--;
+	mDamage[inIndex] = mDamage[mDamageCount];
+}
+
+/******************************** EraseRect16 *********************************/
+/*
+*	Fills inRect with the background color.  The current position is
+*	preserved.
+*/
+void DisplayController::EraseRect16(
+	const Rect16_t&	inRect)
+{
+	uint16_t	row = mRow;
+	uint16_t	column = mColumn;
+	MoveTo(inRect.y, inRect.x);
+	SetColumnRange(inRect.width);
+	FillPixels((uint32_t)inRect.width * inRect.height, mBGColor);
+	MoveTo(row, column);
+}
+#endif
+
 /********************************* DrawFrame **********************************/
 void DisplayController::DrawFrame(
 	uint16_t	inX,
@@ -272,6 +574,10 @@ void DisplayController::DrawFrame(
 	uint16_t	inColor,
 	uint8_t		inThickness)
 {
+	Cover(inY, inX, inThickness, inWidth);
+	Cover(inY+inHeight-inThickness, inX, inThickness, inWidth);
+	Cover(inY+inThickness, inX, inHeight-(inThickness*2), inThickness);
+	Cover(inY+inThickness, inX + inWidth - inThickness, inHeight-(inThickness*2), inThickness);
 	MoveTo(inY, inX);
 	SetColumnRange(inWidth);
 	FillPixels(inWidth * inThickness, inColor);
@@ -333,6 +639,7 @@ uint8_t DisplayController::DrawCircle(
 	int16_t		inOctantXOffset,
 	int16_t		inOctantYOffset)
 {
+	FlushDamage();	// Not opaque
 	int16_t	xOffset = inCenterX - inRadius;
 	int16_t	yOffset = inCenterY - inRadius;
 	/*
@@ -508,38 +815,27 @@ uint8_t DisplayController::DrawCircle(
 				x0 != y0 ||
 				*patternPtr != 255)
 			{
-				if (inOctants & eNNEOctant)
-				{
-					CopyTintedPattern(xx1, yy0, patternPtr, patternLen, 1, false, true);
-				}
-				if (inOctants & eENEOctant)
-				{
-					CopyTintedPattern(xx2, yx0, patternPtr, patternLen, 1, true, false);
-				}
-				if (inOctants & eESEOctant)
-				{
-					CopyTintedPattern(xx2, yx1, patternPtr, patternLen, 1, true, true);
-				}
-				if (inOctants & eSSEOctant)
-				{
-					CopyTintedPattern(xx1, yx2, patternPtr, patternLen, 1, false, true);
-				}
-				if (inOctants & eSSWOctant)
-				{
-					CopyTintedPattern(xx0, yx2, patternPtr, patternLen, 1, false, false);
-				}
-				if (inOctants & eWSWOctant)
-				{
-					CopyTintedPattern(xy0, yx1, patternPtr, patternLen, 1, true, true);
-				}
-				if (inOctants & eWNWOctant)
-				{
-					CopyTintedPattern(xy0, yx0, patternPtr, patternLen, 1, true, false);
-				}
-				if (inOctants & eNNWOctant)
+				/*
+				*	The colors are calculated once per row and shared by all of
+				*	the octants.  The reversed copy follows the colors so that
+				*	octants that meet (e.g. NNW and NNE when there's no
+				*	offset) can be copied as a single span.
+				*/
+				uint16_t	colors[patternLen*2];
+				uint16_t*	reversedColors = &colors[patternLen];
+				TintsToColors(patternPtr, patternLen, colors);
+				for (int32_t i = 0; i < patternLen; i++)
 				{
-					CopyTintedPattern(xx0, yy0, patternPtr, patternLen, 1, false, false);
+					reversedColors[i] = colors[patternLen-1-i];
 				}
+				CopySpanPair(inOctants & eNNWOctant, inOctants & eNNEOctant,
+								xx0, yy0, xx1, yy0, colors, patternLen, false);
+				CopySpanPair(inOctants & eENEOctant, inOctants & eESEOctant,
+								xx2, yx0, xx2, yx1, colors, patternLen, true);
+				CopySpanPair(inOctants & eSSWOctant, inOctants & eSSEOctant,
+								xx0, yx2, xx1, yx2, colors, patternLen, false);
+				CopySpanPair(inOctants & eWNWOctant, inOctants & eWSWOctant,
+								xy0, yx0, xy0, yx1, colors, patternLen, true);
 			/*
 			*	Else at this point there are only rectangular areas representing
 			*	the remainder of one or more quadrants. (100% fill optimization)
@@ -606,6 +902,7 @@ uint8_t DisplayController::DrawCircle(
 	int16_t	inOctantXOffset,
 	int16_t	inOctantYOffset)
 {
+	FlushDamage();	// Not opaque
 	int16_t	xOffset = inCenterX - inRadius-1;
 	int16_t	yOffset = inCenterY - inRadius-1;
 	inRadius++;
@@ -817,6 +1114,7 @@ void DisplayController::DrawLine(
 	int16_t		inThickness,
 	bool		inUseMask)
 {
+	FlushDamage();	// Not opaque
 	if (inThickness == 0)
 	{
 		inThickness = 1;
@@ -1146,10 +1444,16 @@ void DisplayController::DrawLine(
 						patternInset = ClipX(oX, clippedPatternLen);
 						ClipY(oY, reps);
 					}
+					/*
+					*	The colors are calculated once and used by both the
+					*	pattern and its mirror.
+					*/
+					uint16_t	colors[patternLen];
+					TintsToColors(pattern, patternLen, colors);
 					if (reps && clippedPatternLen)
 					{
 						lastX = oX;
-						CopyTintedPattern(oX, oY, &pattern[patternInset], clippedPatternLen, 1, swapXY, false);
+						CopySpan(oX, oY, &colors[patternInset], clippedPatternLen, swapXY);
 					}
 					if (y < mirrorY)
 					{
@@ -1186,7 +1490,13 @@ void DisplayController::DrawLine(
 						if (reps && patternLen)
 						{
 							lastXM = oX;
-							CopyTintedPattern(oX, oY, &pattern[patternInset], patternLen, 1, swapXY, true);
+							uint16_t	reversedColors[patternLen];
+							const uint16_t*	colorsPtr = &colors[patternInset+patternLen];
+							for (int32_t i = 0; i < patternLen; i++)
+							{
+								reversedColors[i] = *(--colorsPtr);
+							}
+							CopySpan(oX, oY, reversedColors, patternLen, swapXY);
 						}
 					}
 				}
@@ -1226,6 +1536,80 @@ void DisplayController::CopyTintedPattern(
 	// See TFT_ST77XX::CopyTintedPattern for an implementation example
 }
 
+/******************************* TintsToColors ********************************/
+void DisplayController::TintsToColors(
+	const uint8_t*	inTints,
+	uint16_t		inLength,
+	uint16_t*		outColors)
+{
+	if (inLength)
+	{
+		uint8_t		lastTint = inTints[0] + 1;
+		uint16_t	color = 0;
+		for (uint16_t i = 0; i < inLength; i++)
+		{
+			uint8_t	thisTint = inTints[i];
+			if (lastTint != thisTint)
+			{
+				lastTint = thisTint;
+				color = NativePixel(Calc565Color(mFGColor, mBGColor, thisTint));
+			}
+			outColors[i] = color;
+		}
+	}
+}
+
+/********************************* CopySpan ***********************************/
+void DisplayController::CopySpan(
+	uint16_t		inX,
+	uint16_t		inY,
+	const uint16_t*	inColors,
+	uint16_t		inLength,
+	bool			inVertical)
+{
+	MoveTo(inY, inX);
+	SetColumnRange(inVertical ? 1 : inLength);
+	CopyPixels(inColors, inLength);
+}
+
+/******************************* CopySpanPair *********************************/
+/*
+*	Used by DrawCircle to copy a pair of octants that share a row (or column
+*	when inVertical.)  inColors is the pattern colors followed by the same
+*	colors reversed.  The first octant is copied from the pattern colors at
+*	inX0, inY0, the second from the reversed colors at inX1, inY1.  When both
+*	are copied and the first ends where the second starts, the pair is copied
+*	as one span.
+*/
+void DisplayController::CopySpanPair(
+	bool			inCopyFirst,
+	bool			inCopySecond,
+	uint16_t		inX0,
+	uint16_t		inY0,
+	uint16_t		inX1,
+	uint16_t		inY1,
+	const uint16_t*	inColors,
+	uint16_t		inLength,
+	bool			inVertical)
+{
+	if (inCopyFirst && inCopySecond &&
+		(inVertical ? (inX0 == inX1 && inY0 + inLength == inY1) :
+					(inY0 == inY1 && inX0 + inLength == inX1)))
+	{
+		CopySpan(inX0, inY0, inColors, inLength*2, inVertical);
+	} else
+	{
+		if (inCopyFirst)
+		{
+			CopySpan(inX0, inY0, inColors, inLength, inVertical);
+		}
+		if (inCopySecond)
+		{
+			CopySpan(inX1, inY1, &inColors[inLength], inLength, inVertical);
+		}
+	}
+}
+
 /********************************* DrawFrameP *********************************/
 /*void DisplayController::DrawFrameP(
 	const Rect8_t*	inRect,
@@ -1271,6 +1655,7 @@ bool DisplayController::StreamCopyBlock(
 		uint16_t	pixelsToCopy = inRows * inColumns;
 		if (pixelsToCopy)
 		{
+			Cover(mRow, mColumn, inRows, inColumns);
 			if (mAddressingMode == eHorizontal)
 			{
 				SetColumnRange(inColumns);
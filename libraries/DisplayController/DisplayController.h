@@ -25,6 +25,28 @@
 
 #include "PlatformDefs.h"
 
+/*
+*	When DISPLAY_NATIVE_PIXELS is non-zero, the 16 bit 565 pixel buffers
+*	passed to CopyPixels and read from the DataStream by StreamCopy are in
+*	the byte order the display controller expects, msb first.  The drivers
+*	can then send the buffers without swapping the bytes of each pixel.
+*	Colors passed by value (FillPixels, FillBlock, Calc565Color, etc.) are
+*	not affected.  Whatever fills a pixel buffer converts the colors it uses
+*	with NativePixel.
+*/
+#ifndef DISPLAY_NATIVE_PIXELS
+#define DISPLAY_NATIVE_PIXELS	1
+#endif
+
+/*
+*	DISPLAY_DAMAGE_RECTS is the maximum number of erased rectangles that can
+*	be deferred while a frame is open (see BeginFrame.)  When the list is full
+*	the excess is erased immediately.  0 removes frame support.
+*/
+#ifndef DISPLAY_DAMAGE_RECTS
+#define DISPLAY_DAMAGE_RECTS	6
+#endif
+
 class DataStream;
 
 typedef struct Rect8_t
@@ -42,6 +64,14 @@ typedef struct Rect8_t
 								{memcpy_P(this, &inRect, 4);}
 } Rect8_t;
 
+typedef struct Rect16_t
+{
+	uint16_t	x;
+	uint16_t	y;
+	uint16_t	width;
+	uint16_t	height;
+} Rect16_t;
+
 class DisplayController
 {
 public:
@@ -94,6 +124,40 @@ public:
 	uint16_t				GetColumns(void) const
 								{return(mColumns);}
 	/*
+	*	SetScrollArea: Defines rows inFirstRow to inFirstRow + inRows - 1 as a
+	*	hardware scrolling area with a scroll offset of 0.  Passing an inRows
+	*	of 0 ends scrolling.  Returns false if the display doesn't support
+	*	vertical scrolling (or not in its current rotation.)
+	*
+	*	Nothing in the gateway uses scrolling.  Controllers such as the
+	*	ST77XX scroll rows only (VSCRDEF scrolls frame memory lines), while
+	*	the gateway's altitude profile advances by columns at its rotation of
+	*	180, and merges columns rather than scrolling when it fills.
+	*/
+	virtual bool			SetScrollArea(
+								uint16_t				inFirstRow,
+								uint16_t				inRows)
+								{return(false);}
+	/*
+	*	ScrollTo: Scrolls the content of the scrolling area up by inOffset
+	*	rows (0 to rows-1) relative to where it was drawn.  The rows that
+	*	scroll off the top reappear at the bottom.
+	*/
+	virtual void			ScrollTo(
+								uint16_t				inOffset){}
+	/*
+	*	ScrolledRow: Returns the row to draw to so that the pixels appear at
+	*	row inRow of the display.  inRow is returned unchanged when it's
+	*	outside of the scrolling area.
+	*
+	*	A strip chart that advances one row per sample increments the offset
+	*	by one, then draws the new sample at ScrolledRow(last row of area.)
+	*/
+	uint16_t				ScrolledRow(
+								uint16_t				inRow) const;
+	uint16_t				GetScrollOffset(void) const
+								{return(mScrollOffset);}
+	/*
 	*	Turns the display off.
 	*/
 	virtual void			Sleep(void) = 0;
@@ -139,6 +203,46 @@ public:
 	void					FillRect8(
 								const Rect8_t*			inRect,
 								uint16_t				inFillColor);
+	/*
+	*	EraseBlock: Same as FillBlock using the background color, except that
+	*	when a frame is open the block is only recorded as damaged.
+	*/
+	void					EraseBlock(
+								uint16_t				inRows,
+								uint16_t				inColumns);
+	/*
+	*	BeginFrame: Opens a frame.  Until EndFrame is called, blocks erased by
+	*	EraseBlock are deferred.  Opaque drawing (FillBlock, StreamCopyBlock,
+	*	DrawFrame, and anything reported via Cover) removes what it covers from
+	*	the deferred blocks.  EndFrame erases whatever remains.  An area that
+	*	is erased and then redrawn within a frame is only written once, and
+	*	doesn't flicker.
+	*/
+	void					BeginFrame(void);
+	void					EndFrame(void);
+	/*
+	*	Cover: Called just before opaque pixels are written to the block at
+	*	inRow, inColumn, inRows x inColumns by anything other than the
+	*	DisplayController drawing routines (e.g. CopyPixels.)
+	*/
+	inline void				Cover(
+								uint16_t				inRow,
+								uint16_t				inColumn,
+								uint16_t				inRows,
+								uint16_t				inColumns)
+							{
+							#if DISPLAY_DAMAGE_RECTS
+								if (mDamageCount)
+								{
+									AddCover(inRow, inColumn, inRows, inColumns);
+								}
+							#endif
+							}
+	/*
+	*	FlushDamage: Erases the deferred blocks now.  Called before drawing
+	*	that doesn't completely cover the area it touches (e.g. DrawCircle.)
+	*/
+	void					FlushDamage(void);
 								
 	/*
 	*	DrawFrame: Draws an inThickness pixel frame at (x,y, w, h).  The frame
@@ -212,6 +316,25 @@ public:
 								uint16_t				inReps,
 								bool					inVertical,
 								bool					inReverseOrder);
+	/*
+	*	TintsToColors: Converts inLength tints to pixel buffer colors using the
+	*	foreground and background colors.  Calc565Color is only called when
+	*	the tint changes.
+	*/
+	void					TintsToColors(
+								const uint8_t*			inTints,
+								uint16_t				inLength,
+								uint16_t*				outColors);
+	/*
+	*	CopySpan: Copies inLength pixel buffer colors to the row (or column
+	*	when inVertical) starting at inX, inY as a single address window.
+	*/
+	void					CopySpan(
+								uint16_t				inX,
+								uint16_t				inY,
+								const uint16_t*			inColors,
+								uint16_t				inLength,
+								bool					inVertical);
 	uint16_t				DrawRoundedRect(
 								int16_t					inX,
 								int16_t					inY,
@@ -279,9 +402,26 @@ public:
 								DataStream*				inDataStream,
 								uint16_t				inPixelsToCopy) = 0;
 								
+	/*
+	*	CopyPixels: Copies inPixelsToCopy 16 bit pixels starting at the
+	*	current row and column.  See DISPLAY_NATIVE_PIXELS.
+	*/
 	virtual void			CopyPixels(
 								const void*				inPixels,
 								uint16_t				inPixelsToCopy){};
+	/*
+	*	NativePixel: Converts a 565 color to or from the pixel buffer byte
+	*	order.  Assumes a little endian MCU.
+	*/
+	static inline uint16_t	NativePixel(
+								uint16_t				inColor)
+							{
+							#if DISPLAY_NATIVE_PIXELS
+								return((inColor << 8) | (inColor >> 8));
+							#else
+								return(inColor);
+							#endif
+							}
 	enum EAddressingMode
 	{
 		eHorizontal,
@@ -338,6 +478,40 @@ protected:
 	EAddressingMode	mAddressingMode;
 	uint16_t	mFGColor;
 	uint16_t	mBGColor;
+	uint16_t	mScrollFirstRow;
+	uint16_t	mScrollRows;	// 0 when not scrolling
+	uint16_t	mScrollOffset;
+
+	void					CopySpanPair(
+								bool					inCopyFirst,
+								bool					inCopySecond,
+								uint16_t				inX0,
+								uint16_t				inY0,
+								uint16_t				inX1,
+								uint16_t				inY1,
+								const uint16_t*			inColors,
+								uint16_t				inLength,
+								bool					inVertical);
+#if DISPLAY_DAMAGE_RECTS
+	bool		mFrameOpen;
+	uint8_t		mDamageCount;
+	Rect16_t	mCover;			// Pending cover, coalesced as glyphs are drawn
+	Rect16_t	mDamage[DISPLAY_DAMAGE_RECTS];
+
+	void					AddCover(
+								uint16_t				inRow,
+								uint16_t				inColumn,
+								uint16_t				inRows,
+								uint16_t				inColumns);
+	void					ApplyCover(void);
+	void					AddDamage(
+								const Rect16_t&			inRect,
+								bool					inMerge);
+	void					RemoveDamage(
+								uint8_t					inIndex);
+	void					EraseRect16(
+								const Rect16_t&			inRect);
+#endif
 };
 
 #endif // DisplayController_h
@@ -0,0 +1,207 @@
+/*
+*	MonoFrameBuffer.cpp, Copyright Jonathan Mackey 2023
+*	Off-screen framebuffer for the 1 bit page addressed display controllers.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#include "MonoFrameBuffer.h"
+#include "DataStream.h"
+#include <string.h>
+
+/****************************** MonoFrameBuffer *******************************/
+/*
+*	The buffer is cleared and marked as changed so that the first Flush
+*	initializes the display.
+*/
+MonoFrameBuffer::MonoFrameBuffer(
+	DisplayController*	inDisplay,
+	uint8_t*			inBuffer)
+	: DisplayController(inDisplay->GetRows(), inDisplay->GetColumns()),
+	  mDisplay(inDisplay), mBuffer(inBuffer), mStartColumn(0), mStartRow(0),
+	  mDataRow(0), mDataColumn(0)
+{
+	/*
+	*	The changed column ranges are tracked for at most kMaxPages pages.
+	*	The pages of a taller display beyond kMaxPages aren't buffered.
+	*/
+	if (mRows > kMaxPages)
+	{
+		mRows = kMaxPages;
+	}
+	mEndColumn = mColumns-1;
+	mEndRow = mRows-1;
+	memset(mBuffer, 0, mRows * mColumns);
+	Invalidate();
+}
+
+/*********************************** MoveTo ***********************************/
+void MonoFrameBuffer::MoveTo(
+	uint16_t	inRow,
+	uint16_t	inColumn)
+{
+	mRow = inRow;
+	mColumn = inColumn;
+}
+
+/******************************* SetColumnRange *******************************/
+void MonoFrameBuffer::SetColumnRange(
+	uint16_t	inStartColumn,
+	uint16_t	inEndColumn)
+{
+	mStartColumn = inStartColumn;
+	mEndColumn = inEndColumn < mColumns ? inEndColumn : mColumns-1;
+}
+
+/******************************** SetRowRange *********************************/
+void MonoFrameBuffer::SetRowRange(
+	uint16_t	inStartPage,
+	uint16_t	inEndPage)
+{
+	mStartRow = inStartPage;
+	mEndRow = inEndPage < mRows ? inEndPage : mRows-1;
+}
+
+/********************************* IncCoords **********************************/
+/*
+*	Advances the write position within the window the same way the
+*	controllers do for the current addressing mode.
+*/
+void MonoFrameBuffer::IncCoords(void)
+{
+	if (mAddressingMode)	// If vertical
+	{
+		mDataRow++;
+		if (mDataRow > mEndRow)
+		{
+			mDataRow = mStartRow;
+			mDataColumn++;
+			if (mDataColumn > mEndColumn)
+			{
+				mDataColumn = mStartColumn;
+			}
+		}
+	} else
+	{
+		mDataColumn++;
+		if (mDataColumn > mEndColumn)
+		{
+			mDataColumn = mStartColumn;
+			mDataRow++;
+			if (mDataRow > mEndRow)
+			{
+				mDataRow = mStartRow;
+			}
+		}
+	}
+}
+
+/********************************* WriteByte **********************************/
+void MonoFrameBuffer::WriteByte(
+	uint8_t	inByte)
+{
+	uint8_t*	byte = &mBuffer[mDataRow * mColumns + mDataColumn];
+	if (*byte != inByte)
+	{
+		*byte = inByte;
+		if (mDataColumn < mFirstChanged[mDataRow])
+		{
+			mFirstChanged[mDataRow] = mDataColumn;
+		}
+		if (mDataColumn > mLastChanged[mDataRow])
+		{
+			mLastChanged[mDataRow] = mDataColumn;
+		}
+	}
+	IncCoords();
+}
+
+/********************************* FillPixels *********************************/
+void MonoFrameBuffer::FillPixels(
+	uint32_t	inBytesToFill,
+	uint16_t	inFillColor)
+{
+	mDataRow = mRow;
+	mDataColumn = mColumn;
+	uint8_t	fillData = inFillColor ? 0xFF : 0;
+	for (; inBytesToFill; inBytesToFill--)
+	{
+		WriteByte(fillData);
+	}
+}
+
+/******************************** StreamCopy **********************************/
+void MonoFrameBuffer::StreamCopy(
+	DataStream*	inDataStream,
+	uint16_t	inBytesToCopy)
+{
+	uint8_t	buffer[32];
+	mDataRow = mRow;
+	mDataColumn = mColumn;
+	while (inBytesToCopy)
+	{
+		uint16_t bytesToWrite = inBytesToCopy > 32 ? 32 : inBytesToCopy;
+		inBytesToCopy -= bytesToWrite;
+		inDataStream->Read(bytesToWrite, buffer);
+		for (uint8_t i = 0; i < bytesToWrite; i++)
+		{
+			WriteByte(buffer[i]);
+		}
+	}
+}
+
+/********************************* Invalidate *********************************/
+void MonoFrameBuffer::Invalidate(void)
+{
+	for (uint8_t page = 0; page < mRows; page++)
+	{
+		mFirstChanged[page] = 0;
+		mLastChanged[page] = mColumns-1;
+	}
+}
+
+/*********************************** Flush ************************************/
+/*
+*	The pages are copied using horizontal addressing.  The display's
+*	addressing mode is set here because it may have been left in vertical
+*	mode by code that drew to it directly.
+*/
+void MonoFrameBuffer::Flush(void)
+{
+	bool	addressingModeSet = false;
+	for (uint8_t page = 0; page < mRows; page++)
+	{
+		uint8_t	firstChanged = mFirstChanged[page];
+		uint8_t	lastChanged = mLastChanged[page];
+		if (firstChanged <= lastChanged)
+		{
+			if (!addressingModeSet)
+			{
+				mDisplay->SetAddressingMode(eHorizontal);
+				addressingModeSet = true;
+			}
+			uint8_t	bytesToCopy = lastChanged - firstChanged + 1;
+			DataStream_S	pageData(&mBuffer[page * mColumns + firstChanged], bytesToCopy);
+			mDisplay->MoveTo(page, firstChanged);
+			mDisplay->SetColumnRange(firstChanged, lastChanged);
+			mDisplay->StreamCopy(&pageData, bytesToCopy);
+			mFirstChanged[page] = 0xFF;
+			mLastChanged[page] = 0;
+		}
+	}
+}
@@ -0,0 +1,113 @@
+/*
+*	MonoFrameBuffer.h, Copyright Jonathan Mackey 2023
+*	Off-screen framebuffer for the 1 bit page addressed display controllers.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef MonoFrameBuffer_h
+#define MonoFrameBuffer_h
+
+#include "DisplayController.h"
+
+/*
+*	MonoFrameBuffer is drawn to in place of a 1 bit display controller
+*	(OLED_SSD1306, LCD_ST7567, LCD_PCD8544.)  Drawing is done in RAM using the
+*	same page/column addressing and windowing as the controllers.  Flush sends
+*	the changed part of each page to the display.
+*
+*	A byte is only marked as changed when the value written differs from the
+*	value in the buffer, so redrawing unchanged content costs nothing on the
+*	bus.  For each page the first and last changed columns are tracked, so a
+*	flush is at most one write per page.
+*
+*	The buffer passed to the constructor must be rows (pages) x columns
+*	bytes, e.g. 1KB for a 128x64 display.  At most kMaxPages (8) pages are
+*	buffered.
+*/
+class MonoFrameBuffer : public DisplayController
+{
+public:
+							MonoFrameBuffer(
+								DisplayController*		inDisplay,
+								uint8_t*				inBuffer);
+	virtual uint8_t			BitsPerPixel(void) const
+								{return(1);}
+	virtual void			MoveTo(
+								uint16_t				inRow,
+								uint16_t				inColumn);
+	virtual void			MoveToRow(
+								uint16_t				inRow)
+								{mRow = inRow;}
+	virtual void			MoveToColumn(
+								uint16_t				inColumn)
+								{mColumn = inColumn;}
+	virtual void			Sleep(void)
+								{mDisplay->Sleep();}
+	virtual void			WakeUp(void)
+								{mDisplay->WakeUp();}
+	/*
+	*	FillPixels: Sets a run of inBytesToFill to inFillColor from the
+	*	current position and window.  inFillColor is used as 0 or 0xFF for
+	*	any non-zero value.
+	*/
+	virtual void			FillPixels(
+								uint32_t				inBytesToFill,
+								uint16_t				inFillColor);
+	virtual void			SetColumnRange(
+								uint16_t				inStartColumn,
+								uint16_t				inEndColumn);
+	virtual void			SetRowRange(
+								uint16_t				inStartPage,
+								uint16_t				inEndPage);
+	virtual void			StreamCopy(
+								DataStream*				inDataStream,
+								uint16_t				inBytesToCopy);
+	virtual void			SetAddressingMode(
+								EAddressingMode			inAddressingMode)
+								{mAddressingMode = inAddressingMode;}
+	/*
+	*	Flush: Writes the changed bytes of each page to the display.
+	*/
+	void					Flush(void);
+	/*
+	*	Invalidate: Marks the entire buffer as changed so that the next Flush
+	*	writes everything, e.g. after the display has been reset.
+	*/
+	void					Invalidate(void);
+	const uint8_t*			GetBuffer(void) const
+								{return(mBuffer);}
+protected:
+	static const uint8_t	kMaxPages = 8;	// 64 pixels
+	DisplayController*	mDisplay;
+	uint8_t*	mBuffer;
+	uint8_t		mStartColumn;	// Window (column range)
+	uint8_t		mEndColumn;
+	uint8_t		mStartRow;		// Window (row range)
+	uint8_t		mEndRow;
+	uint8_t		mDataRow;		// Write position within the window
+	uint8_t		mDataColumn;
+	uint8_t		mFirstChanged[kMaxPages];	// 0xFF when nothing changed
+	uint8_t		mLastChanged[kMaxPages];
+
+	void					WriteByte(
+								uint8_t					inByte);
+	void					IncCoords(void);
+};
+
+#endif // MonoFrameBuffer_h
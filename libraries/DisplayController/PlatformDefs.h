@@ -40,6 +40,8 @@
 		typedef int8_t pin_t;
 	#endif
 #else
+typedef uint8_t port_t;
+typedef int8_t pin_t;
 #ifndef memcpy_P
 	#define memcpy_P memcpy
 #endif
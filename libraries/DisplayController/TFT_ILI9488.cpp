@@ -122,91 +122,29 @@ void TFT_ILI9488::Init(void)
 /*
 *	This is an override of the TFT_ST77XX routine.  This override converts
 *	RGB565 to RGB666.  See k5To6Bit at top of file.
+*
+*	When each channel of inFillColor is either off or fully on (black, white,
+*	and the primary and secondary colors) the pixels are written in the 3-bit
+*	pixel format, two pixels per byte.  Switching the pixel format costs 5
+*	bytes, so fills of less than 4 pixels are written as 18-bit.
 */
 void TFT_ILI9488::FillPixels(
 	uint32_t	inPixelsToFill,
 	uint16_t	inFillColor)
 {
-#if 1
-	bool use3Bit = true;
-	uint8_t fillColor = 0;
-	/*
-	*	This switch determines if 3-bit can be used.
-	*/
-	switch (inFillColor)	// BGR
-	{
-		case 0:			// 000	Black
-			break;
-		case 0x001F:	// 001	Red
-			fillColor = 0b001001;	// Two 3-bit pixels of red
-			break;
-		case 0x07E0:	// 010	Green
-			fillColor = 0b010010;
-			break;
-		case 0x07FF:	// 011	Yellow
-			fillColor = 0b011011;
-			break;
-		case 0xF800:	// 100	Blue
-			fillColor = 0b100100;
-			break;
-		case 0xF81F:	// 101	Magenta
-			fillColor = 0b101101;
-			break;
-		case 0xFFFE:	// 110	Cyan
-			fillColor = 0b110110;
-			break;
-		case 0xFFFF:	// 111	White
-			fillColor = 0b111111;
-			break;
-		default:
-		/*
-		*	The default 18-bit fill is used when inFillColor is not 100% white,
-		*	black, red, green, blue, cyan, magenta or yellow.  These are the
-		*	only colors supported by the 3-bit pixel format.
-		*/
-		{
-			use3Bit = false;
-			// Note: I tried quadrupling the buffer size from 288 to 1152.
-			//		 The time savings was negligable.
-			uint8_t	buffer[288];	// 96 18-bit pixels (96 = 480/5)
-			const uint32_t	kMaxPixels = sizeof(buffer)/3;
-			uint8_t b = k5To6Bit[(inFillColor >> 11)];
-			uint8_t g = (inFillColor >> 3) & 0xFC;
-			uint8_t r = k5To6Bit[inFillColor & 0x1F];
-			BeginTransaction();
-			/*
-			*	There are ways to do this more efficiently on a ESP32 or STM32 mcu.
-			*	For ESP32 there's an option to copy a pattern.
-			*	For STM32 there's an option to not receive on the transfer so you only
-			*	have to fill the buffer once.
-			*/
-			while (inPixelsToFill)
-			{
-				uint32_t	bufferLen = inPixelsToFill > kMaxPixels ? kMaxPixels : inPixelsToFill;
-				uint8_t*	bufferPtr = buffer;
-				for (uint32_t i = 0; i < bufferLen; i++)
-				{
-					*(bufferPtr++) = b;
-					*(bufferPtr++) = g;
-					*(bufferPtr++) = r;
-				}
-				inPixelsToFill -= bufferLen;
-				SPI.transfer(buffer, bufferLen*3);
-			}
-			EndTransaction();
-			break;
-		}
-	}
-	if (use3Bit)
+	uint8_t	b = k5To6Bit[(inFillColor >> 11)];
+	uint8_t	g = (inFillColor >> 3) & 0xFC;
+	uint8_t	r = k5To6Bit[inFillColor & 0x1F];
+	BeginTransaction();
+	WriteWindowCmds();
+	if (inPixelsToFill >= 4 &&
+		(b == 0 || b == 0xFC) &&
+		(g == 0 || g == 0xFC) &&
+		(r == 0 || r == 0xFC))
 	{
-		/*
-		*	Optimization for 3-bit pixels.
-		*/
-		uint8_t	buffer[240];	// 480 3-bit pixels
-		bool	oddPixel = (inPixelsToFill & 1) != 0;
+		uint8_t	pixel3Bit = (b ? 4 : 0) | (g ? 2 : 0) | (r ? 1 : 0);
+		uint8_t	fillColor = (pixel3Bit << 3) | pixel3Bit;	// Two 3-bit pixels
 		uint32_t	pixelPairs = inPixelsToFill/2;
-	
-		BeginTransaction();
 		/*
 		*	If there are an odd number of pixels THEN
 		*	write the odd pixel first.
@@ -218,54 +156,95 @@ void TFT_ILI9488::FillPixels(
 		*	start of the block.  If the row range was set then you could just
 		*	wrap around and write the first pixel twice.
 		*/
-		if (oddPixel)
+		if (inPixelsToFill & 1)
 		{
-			buffer[0]=fillColor & 4 ? 0xFC : 0;
-			buffer[1]=fillColor & 2 ? 0xFC : 0;
-			buffer[2]=fillColor & 1 ? 0xFC : 0;
-			SPI.transfer(buffer, 3);
+			Write18BitFill(b, g, r, 1);
 		}
-		if (pixelPairs)
+		WriteCmd(eCOLMODCmd);	// Set Interface Pixel Format
+		SPI.transfer(0x61);		// to 3-bit
+		WriteCmd(eWRMEMCCmd);	// Continue with write
+	#if TFT_ST77XX_PIPELINED_SPI
+		SPDR = fillColor;
+		while (--pixelPairs)
 		{
-			WriteCmd(eCOLMODCmd);	// Set Interface Pixel Format
-			SPI.transfer(0x61);		// to 3-bit
-			WriteCmd(eWRMEMCCmd);	// Continue with write
-			/*
-			*	There are ways to do this more efficiently on a ESP32 or STM32 mcu.
-			*	For ESP32 there's an option to copy a pattern.
-			*	For STM32 there's an option to not receive on the transfer so you only
-			*	have to fill the buffer once.
-			*/
-			while (pixelPairs)
-			{
-				uint32_t	bufferLen = pixelPairs > sizeof(buffer) ? sizeof(buffer) : pixelPairs;
-				for (uint32_t i = 0; i < bufferLen; i++)
-				{
-					buffer[i] = fillColor;	// Lower 6 bits used (2 pixels)
-				}
-				pixelPairs -= bufferLen;
-				SPI.transfer(buffer, bufferLen);
-			}
-			WriteCmd(eCOLMODCmd);	// Set Interface Pixel Format
-			SPI.transfer(0x66);		// back to 18-bit
-			//WriteCmd(eRAMWRCmd);
+			WaitForSPI();
+			SPDR = fillColor;
 		}
-		EndTransaction();
-	}
-#else
-	// Least efficient
-	uint8_t r = k5To6Bit[(inFillColor >> 11)];
-	uint8_t g = (inFillColor >> 3) & 0xFC;
-	uint8_t b = k5To6Bit[inFillColor & 0x1F];
-	BeginTransaction();
-	for (; inPixelsToFill; inPixelsToFill--)
+		WaitForSPI();
+	#else
+		/*
+		*	There are ways to do this more efficiently on a ESP32 or STM32 mcu.
+		*	For ESP32 there's an option to copy a pattern.
+		*	For STM32 there's an option to not receive on the transfer so you only
+		*	have to fill the buffer once.
+		*/
+		uint8_t	buffer[240];	// 480 3-bit pixels
+		while (pixelPairs)
+		{
+			uint32_t	bufferLen = pixelPairs > sizeof(buffer) ? sizeof(buffer) : pixelPairs;
+			memset(buffer, fillColor, bufferLen);	// Lower 6 bits used (2 pixels)
+			pixelPairs -= bufferLen;
+			SPI.transfer(buffer, bufferLen);
+		}
+	#endif
+		WriteCmd(eCOLMODCmd);	// Set Interface Pixel Format
+		SPI.transfer(0x66);		// back to 18-bit
+	} else
 	{
-		SPI.transfer(r);
-		SPI.transfer(g);
-		SPI.transfer(b);
+		Write18BitFill(b, g, r, inPixelsToFill);
 	}
 	EndTransaction();
-#endif
+}
+
+/******************************* Write18BitFill *******************************/
+/*
+*	Writes inPixelsToFill of the 18-bit pixel inB, inG, inR (already
+*	converted to RGB666.)
+*/
+void TFT_ILI9488::Write18BitFill(
+	uint8_t		inB,
+	uint8_t		inG,
+	uint8_t		inR,
+	uint32_t	inPixelsToFill) const
+{
+	if (inPixelsToFill)
+	{
+	#if TFT_ST77XX_PIPELINED_SPI
+		SPDR = inB;
+		while (true)
+		{
+			WaitForSPI();
+			SPDR = inG;
+			WaitForSPI();
+			SPDR = inR;
+			if (!--inPixelsToFill)
+			{
+				break;
+			}
+			WaitForSPI();
+			SPDR = inB;
+		}
+		WaitForSPI();
+	#else
+		// Note: I tried quadrupling the buffer size from 288 to 1152.
+		//		 The time savings was negligable.
+		uint8_t	buffer[288];	// 96 18-bit pixels (96 = 480/5)
+		const uint32_t	kMaxPixels = sizeof(buffer)/3;
+		while (inPixelsToFill)
+		{
+			uint32_t	bufferLen = inPixelsToFill > kMaxPixels ? kMaxPixels : inPixelsToFill;
+			uint8_t*	bufferPtr = buffer;
+			for (uint32_t i = 0; i < bufferLen; i++)
+			{
+				*(bufferPtr++) = inB;
+				*(bufferPtr++) = inG;
+				*(bufferPtr++) = inR;
+			}
+			inPixelsToFill -= bufferLen;
+			SPI.transfer(buffer, bufferLen*3);
+		}
+	#endif
+	}
 }
 
 /******************************** StreamCopy **********************************/
@@ -274,6 +253,7 @@ void TFT_ILI9488::StreamCopy(
 	uint16_t	inPixelsToCopy)
 {
 	BeginTransaction();
+	WriteWindowCmds();
 	uint16_t	buffer[96];	// WritePixelData's buffer holds 96 pixels.
 	while (inPixelsToCopy)
 	{
@@ -291,6 +271,7 @@ void TFT_ILI9488::CopyPixels(
 	uint16_t		inPixelsToCopy)
 {
 	BeginTransaction();
+	WriteWindowCmds();
 	WritePixelData((const uint16_t*)inPixels, inPixelsToCopy);
 	EndTransaction();
 }
@@ -315,7 +296,35 @@ void TFT_ILI9488::WritePixelData(
 {
 	if (inDataLen)
 	{
-#if 1
+	#if TFT_ST77XX_PIPELINED_SPI
+		/*
+		*	Each channel is converted while the previous byte is being shifted
+		*	out.
+		*/
+		const uint16_t*	endData = &inPixelData[inDataLen];
+		uint16_t	rbg565Color = NativePixel(*(inPixelData++));
+		SPDR = k5To6Bit[(rbg565Color >> 11)];
+		while (true)
+		{
+			uint8_t	g = (rbg565Color >> 3) & 0xFC;
+			uint8_t	r = k5To6Bit[rbg565Color & 0x1F];
+			WaitForSPI();
+			SPDR = g;
+			if (inPixelData >= endData)
+			{
+				WaitForSPI();
+				SPDR = r;
+				break;
+			}
+			rbg565Color = NativePixel(*(inPixelData++));
+			uint8_t	b = k5To6Bit[(rbg565Color >> 11)];
+			WaitForSPI();
+			SPDR = r;
+			WaitForSPI();
+			SPDR = b;
+		}
+		WaitForSPI();
+	#else
 		uint8_t	buffer[288];	// 96 18-bit pixels (96 = 480/5)
 		const uint32_t	kMaxPixels = sizeof(buffer)/3;
 
@@ -325,7 +334,7 @@ void TFT_ILI9488::WritePixelData(
 			uint8_t*	bufferPtr = buffer;
 			for (uint32_t i = 0; i < bufferLen; i++)
 			{
-				uint16_t	rbg565Color = *(inPixelData++);
+				uint16_t	rbg565Color = NativePixel(*(inPixelData++));
 				*(bufferPtr++) = k5To6Bit[(rbg565Color >> 11)];
 				*(bufferPtr++) = (rbg565Color >> 3) & 0xFC;
 				*(bufferPtr++) = k5To6Bit[rbg565Color & 0x1F];
@@ -333,20 +342,7 @@ void TFT_ILI9488::WritePixelData(
 			inDataLen -= bufferLen;
 			SPI.transfer(buffer, bufferLen*3);
 		}
-#else
-	// Least efficient
-		const uint16_t* endData = &inPixelData[inDataLen];
-		do
-		{
-			uint16_t	rbg565Color = *(inPixelData++);
-			uint8_t r = k5To6Bit[(rbg565Color >> 11)];
-			uint8_t g = (rbg565Color >> 3) & 0xFC;
-			uint8_t b = k5To6Bit[rbg565Color & 0x1F];
-			SPI.transfer(r);
-			SPI.transfer(g);
-			SPI.transfer(b);
-		} while (inPixelData < endData);
-#endif
+	#endif
 	}
 }
 
@@ -70,6 +70,11 @@ protected:
 	void					WritePixelData(
 								const uint16_t*			inData,
 								uint16_t				inDataLen) const;
+	void					Write18BitFill(
+								uint8_t					inB,
+								uint8_t					inG,
+								uint8_t					inR,
+								uint32_t				inPixelsToFill) const;
 };
 
 #endif // TFT_ILI9488_h
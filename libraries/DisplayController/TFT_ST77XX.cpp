@@ -48,8 +48,12 @@ TFT_ST77XX::TFT_ST77XX(
 	  mSPISettings(15000000, MSBFIRST, SPI_MODE3),
 	  mCSPin(inCSPin), mDCPin(inDCPin), mResetPin(inResetPin),
 	  mBacklightPin(inBacklightPin), mRowOffset(0), mColOffset(0),
-	  mCentered(inCentered), mIsBGR(inIsBGR), mInvColAddrOrder(inInvColAddrOrder)
+	  mCentered(inCentered), mIsBGR(inIsBGR), mInvColAddrOrder(inInvColAddrOrder),
+	  mRotation(0), mRAMWRPending(false)
 {
+	InvalidateWindow();
+	mNextRowWindow[0] = mNextRowWindow[1] = 0xFFFF;
+	mNextColumnWindow[0] = mNextColumnWindow[1] = 0xFFFF;
 	// Setting the CS pin mode and state was moved from begin to avoid
 	// interference with other SPI devices on the bus.
 	if (mCSPin >= 0)
@@ -102,6 +106,7 @@ void TFT_ST77XX::Init(void)
 	// Per docs: After reset, delay 150ms before sending the next command.
 	// (The controller IC is in the process of writing the defaults.)
 	delay(150);
+	InvalidateWindow();
 	WriteWakeUpCmds();	// By default the controller is asleep after reset.
 }
 
@@ -195,7 +200,30 @@ void TFT_ST77XX::WriteData16(
 {
 	if (inDataLen)
 	{
-	#if 1
+	#if TFT_ST77XX_PIPELINED_SPI
+		/*
+		*	While a byte is being shifted out, the byte that follows it is
+		*	loaded.  The msb of each pixel is sent first.
+		*/
+		const uint8_t*	data = (const uint8_t*)inData;
+		const uint8_t*	endData = data + (inDataLen*2);
+		uint8_t	lsb = data[0];
+		SPDR = data[1];
+		data += 2;
+		while (data < endData)
+		{
+			uint8_t	msb = data[1];
+			WaitForSPI();
+			SPDR = lsb;
+			lsb = data[0];
+			data += 2;
+			WaitForSPI();
+			SPDR = msb;
+		}
+		WaitForSPI();
+		SPDR = lsb;
+		WaitForSPI();
+	#else
 		uint8_t	buffer[96*2];
 		const uint32_t	kMaxPixels = sizeof(buffer)/2;
 		const uint8_t*	data = (const uint8_t*)inData;
@@ -213,17 +241,55 @@ void TFT_ST77XX::WriteData16(
 			inDataLen -= bufferLen;
 			SPI.transfer(buffer, bufferLen*2);
 		}
+	#endif
+	}
+}
+
+/******************************** WritePixels *********************************/
+/*
+*	inPixels is an address in SRAM of a pixel buffer.  When the pixels are
+*	already in the display's byte order they're sent as is, otherwise they're
+*	sent via WriteData16.  See DISPLAY_NATIVE_PIXELS.
+*/
+void TFT_ST77XX::WritePixels(
+	const uint16_t*	inPixels,
+	uint16_t		inPixelsLen) const
+{
+#if DISPLAY_NATIVE_PIXELS
+	if (inPixelsLen)
+	{
+	#if TFT_ST77XX_PIPELINED_SPI
+		const uint8_t*	data = (const uint8_t*)inPixels;
+		const uint8_t*	endData = data + (inPixelsLen*2);
+		SPDR = *(data++);
+		while (data < endData)
+		{
+			uint8_t	nextByte = *(data++);
+			WaitForSPI();
+			SPDR = nextByte;
+		}
+		WaitForSPI();
 	#else
-		const uint8_t*	data = (const uint8_t*)inData;
-		const uint8_t*	endData = data + (inDataLen*2);
-		do
+		/*
+		*	SPI.transfer overwrites the buffer with the data received, so the
+		*	pixels are copied to a buffer first.
+		*/
+		uint8_t	buffer[96*2];
+		const uint8_t*	data = (const uint8_t*)inPixels;
+		uint32_t	dataLen = (uint32_t)inPixelsLen*2;
+		while (dataLen)
 		{
-			uint8_t	lsb = *(data++);
-			SPI.transfer(*(data++));
-			SPI.transfer(lsb);
-		} while (data < endData);
+			uint32_t	bufferLen = dataLen > sizeof(buffer) ? sizeof(buffer) : dataLen;
+			memcpy(buffer, data, bufferLen);
+			data += bufferLen;
+			dataLen -= bufferLen;
+			SPI.transfer(buffer, bufferLen);
+		}
 	#endif
 	}
+#else
+	WriteData16(inPixels, inPixelsLen);
+#endif
 }
 
 /******************************** SetRotation *********************************/
@@ -250,6 +316,7 @@ For both the 89 and 35R the RGB order is BGR.
 
 */
 	inRotation &= 3;
+	mRotation = inRotation;
 	/*
 	*	It looks like there's a manufacturing mistake in the 160x80 displays
 	*	that I have (maybe all?) where RGB is BGR based on the controller
@@ -283,6 +350,7 @@ For both the 89 and 35R the RGB order is BGR.
 	WriteCmd(eMADCTLCmd);
 	SPI.transfer(madctlParam);
 	EndTransaction();
+	InvalidateWindow();
 	{
 		uint16_t	vDelta = VerticalRes() - mRows;
 		uint16_t	hDelta = HorizontalRes() - mColumns;
@@ -314,6 +382,84 @@ For both the 89 and 35R the RGB order is BGR.
 	}
 }
 
+/******************************* SetScrollArea ********************************/
+/*
+*	VSCRDEF defines the scrolling area as frame memory lines: the top fixed
+*	area, the scrolling area, and the bottom fixed area, which together must
+*	equal the number of lines the controller supports (VerticalRes.)  At 180
+*	degrees (MY set) the display rows are in the reverse order of the memory
+*	lines.
+*
+*	Normal Display Mode On (NORON) ends scrolling.
+*/
+bool TFT_ST77XX::SetScrollArea(
+	uint16_t	inFirstRow,
+	uint16_t	inRows)
+{
+	bool	success = (mRotation & 1) == 0 &&
+		(inFirstRow + inRows) <= mRows;
+	if (success)
+	{
+		mScrollFirstRow = inFirstRow;
+		mScrollRows = inRows;
+		mScrollOffset = 0;
+		BeginTransaction();
+		if (inRows)
+		{
+			uint16_t	scrollDef[3];
+			if (mRotation)
+			{
+				scrollDef[0] = VerticalRes() - mRowOffset - inFirstRow - inRows;
+			} else
+			{
+				scrollDef[0] = inFirstRow + mRowOffset;
+			}
+			scrollDef[1] = inRows;
+			scrollDef[2] = VerticalRes() - scrollDef[0] - inRows;
+			WriteCmd(eVSCRDEFCmd);
+			WriteData16(scrollDef, 3);
+			WriteCmd(eVSCSADCmd);
+			WriteData16(scrollDef, 1);	// Start address = top fixed lines
+		} else
+		{
+			WriteCmd(eNORONCmd);
+		}
+		EndTransaction();
+	}
+	return(success);
+}
+
+/********************************** ScrollTo **********************************/
+/*
+*	The scroll start address (VSCSAD) is the memory line shown on the first
+*	line of the scrolling area.  At 180 degrees the memory lines are scrolled
+*	in the opposite direction.
+*/
+void TFT_ST77XX::ScrollTo(
+	uint16_t	inOffset)
+{
+	if (mScrollRows)
+	{
+		mScrollOffset = inOffset % mScrollRows;
+		uint16_t	startLine;
+		if (mRotation)
+		{
+			startLine = VerticalRes() - mRowOffset - mScrollFirstRow - mScrollRows;
+			if (mScrollOffset)
+			{
+				startLine += mScrollRows - mScrollOffset;
+			}
+		} else
+		{
+			startLine = mScrollFirstRow + mRowOffset + mScrollOffset;
+		}
+		BeginTransaction();
+		WriteCmd(eVSCSADCmd);
+		WriteData16(&startLine, 1);
+		EndTransaction();
+	}
+}
+
 /*********************************** Sleep ************************************/
 void TFT_ST77XX::Sleep(void)
 {
@@ -363,12 +509,33 @@ void TFT_ST77XX::FillPixels(
 	uint32_t	inPixelsToFill,
 	uint16_t	inFillColor)
 {
-#if 1
+#if TFT_ST77XX_PIPELINED_SPI
+	uint8_t	msb = inFillColor >> 8;
+	uint8_t	lsb = inFillColor;
+	BeginTransaction();
+	WriteWindowCmds();
+	if (inPixelsToFill)
+	{
+		SPDR = msb;
+		while (--inPixelsToFill)
+		{
+			WaitForSPI();
+			SPDR = lsb;
+			WaitForSPI();
+			SPDR = msb;
+		}
+		WaitForSPI();
+		SPDR = lsb;
+		WaitForSPI();
+	}
+	EndTransaction();
+#else
 	uint8_t	buffer[96*2];
 	const uint32_t	kMaxPixels = sizeof(buffer)/2;
 	uint8_t	msb = inFillColor >> 8;
 	uint8_t	lsb = inFillColor;
 	BeginTransaction();
+	WriteWindowCmds();
 
 	while (inPixelsToFill)
 	{
@@ -383,16 +550,6 @@ void TFT_ST77XX::FillPixels(
 		SPI.transfer(buffer, bufferLen*2);
 	}
 	EndTransaction();
-#else
-	uint8_t	msb = inFillColor >> 8;
-	uint8_t	lsb = inFillColor;
-	BeginTransaction();
-	for (; inPixelsToFill; inPixelsToFill--)
-	{
-		SPI.transfer(msb);
-		SPI.transfer(lsb);
-	}
-	EndTransaction();
 #endif
 }
 
@@ -411,14 +568,8 @@ void TFT_ST77XX::MoveTo(
 void TFT_ST77XX::MoveToRow(
 	uint16_t inRow)
 {
-	uint16_t	rows[2];
-	rows[0] = inRow + mRowOffset;
-	rows[1] = mRows + mRowOffset -1;
-	
-	BeginTransaction();
-	WriteCmd(eRASETCmd);
-	WriteData16(rows, 2);
-	EndTransaction();
+	mNextRowWindow[0] = inRow + mRowOffset;
+	mNextRowWindow[1] = mRows + mRowOffset -1;
 	mRow = inRow;
 }
 
@@ -438,16 +589,10 @@ void TFT_ST77XX::SetColumnRange(
 	uint16_t	inStartColumn,
 	uint16_t	inEndColumn)
 {
-	uint16_t	columns[2];
-	columns[0] = inStartColumn + mColOffset;
-	columns[1] = inEndColumn + mColOffset;
-
-	BeginTransaction();
-	WriteCmd(eCASETCmd);
-	WriteData16(columns, 2);
-	WriteCmd(eRAMWRCmd); // Resets controller memory ptr to inStartColumn and
-						 // the start of current the row frame 
-	EndTransaction();
+	mNextColumnWindow[0] = inStartColumn + mColOffset;
+	mNextColumnWindow[1] = inEndColumn + mColOffset;
+	mRAMWRPending = true;	// Resets controller memory ptr to inStartColumn
+							// and the start of current the row frame
 }
 
 /******************************* SetRowRange *******************************/
@@ -455,16 +600,61 @@ void TFT_ST77XX::SetRowRange(
 	uint16_t	inStartRow,
 	uint16_t	inEndRow)
 {
-	uint16_t	rows[2];
-	rows[0] = inStartRow + mRowOffset;
-	rows[1] = inEndRow + mRowOffset;
-
-	BeginTransaction();
-	WriteCmd(eRASETCmd);
-	WriteData16(rows, 2);
+	mNextRowWindow[0] = inStartRow + mRowOffset;
+	mNextRowWindow[1] = inEndRow + mRowOffset;
 	// Does not send a start RAM write command.
 	// SetRowRange should be called before SetColumnRange.
-	EndTransaction();
+}
+
+/****************************** WriteWindowCmds *******************************/
+/*
+*	MoveToRow, SetRowRange and SetColumnRange only record the window.  The
+*	window commands are written here, within the transaction of the next
+*	pixel write.  RASET and CASET are only written when the window differs
+*	from the window last written to the controller.  RAMWR is written when
+*	SetColumnRange was called since the last pixel write.
+*
+*	Other than the window commands being skipped, the controller sees the
+*	same sequence it would if the commands were written immediately: all of
+*	the drawing code sets the column range before writing pixels.  Resetting
+*	the window after a write (e.g. StreamCopyBlock) costs nothing when the
+*	next operation sets its own window.
+*/
+void TFT_ST77XX::WriteWindowCmds(void)
+{
+	if (mNextRowWindow[0] != mRowWindow[0] ||
+		mNextRowWindow[1] != mRowWindow[1])
+	{
+		mRowWindow[0] = mNextRowWindow[0];
+		mRowWindow[1] = mNextRowWindow[1];
+		WriteCmd(eRASETCmd);
+		WriteData16(mRowWindow, 2);
+	}
+	if (mNextColumnWindow[0] != mColumnWindow[0] ||
+		mNextColumnWindow[1] != mColumnWindow[1])
+	{
+		mColumnWindow[0] = mNextColumnWindow[0];
+		mColumnWindow[1] = mNextColumnWindow[1];
+		WriteCmd(eCASETCmd);
+		WriteData16(mColumnWindow, 2);
+	}
+	if (mRAMWRPending)
+	{
+		mRAMWRPending = false;
+		WriteCmd(eRAMWRCmd);
+	}
+}
+
+/****************************** InvalidateWindow ******************************/
+/*
+*	Called when the controller's window is unknown (after a reset) or no
+*	longer matches the window last written (after a MADCTL change.)  The next
+*	pixel write will write both RASET and CASET.
+*/
+void TFT_ST77XX::InvalidateWindow(void)
+{
+	mRowWindow[0] = 0xFFFF;
+	mColumnWindow[0] = 0xFFFF;
 }
 
 /******************************** StreamCopy **********************************/
@@ -473,13 +663,14 @@ void TFT_ST77XX::StreamCopy(
 	uint16_t	inPixelsToCopy)
 {
 	BeginTransaction();
+	WriteWindowCmds();
 	uint16_t	buffer[96];
 	while (inPixelsToCopy)
 	{
 		uint16_t pixelsToWrite = inPixelsToCopy > 96 ? 96 : inPixelsToCopy;
 		inPixelsToCopy -= pixelsToWrite;
 		inDataStream->Read(pixelsToWrite, buffer);
-		WriteData16(buffer, pixelsToWrite);
+		WritePixels(buffer, pixelsToWrite);
 	}
 	EndTransaction();
 }
@@ -490,7 +681,8 @@ void TFT_ST77XX::CopyPixels(
 	uint16_t		inPixelsToCopy)
 {
 	BeginTransaction();
-	WriteData16((const uint16_t*)inPixels, inPixelsToCopy);
+	WriteWindowCmds();
+	WritePixels((const uint16_t*)inPixels, inPixelsToCopy);
 	EndTransaction();
 }
 
@@ -517,35 +709,14 @@ void TFT_ST77XX::CopyTintedPattern(
 	bool			inReverseOrder)
 {	
 	uint16_t	colorPattern[inPatternLen];
-	uint8_t		thisTint;
-	uint8_t		lastTint;
-	uint16_t	color = 0;
-	if (inReverseOrder)
-	{
-		const uint8_t*	patternPtr = &inTintPattern[inPatternLen-1];
-		lastTint = *patternPtr + 1;
-		for (uint16_t i = 0; i < inPatternLen; i++)
-		{
-			thisTint = *(patternPtr--);
-			if (lastTint != thisTint)
-			{
-				lastTint = thisTint;
-				color = Calc565Color(mFGColor, mBGColor, thisTint);
-			}
-			colorPattern[i] = color;
-		}
-	} else
+	TintsToColors(inTintPattern, inPatternLen, colorPattern);
+	if (inReverseOrder && inPatternLen)
 	{
-		lastTint = inTintPattern[0] + 1;
-		for (uint16_t i = 0; i < inPatternLen; i++)
+		for (uint16_t i = 0, j = inPatternLen-1; i < j; i++, j--)
 		{
-			thisTint = inTintPattern[i];
-			if (lastTint != thisTint)
-			{
-				lastTint = thisTint;
-				color = Calc565Color(mFGColor, mBGColor, thisTint);
-			}
-			colorPattern[i] = color;
+			uint16_t	color = colorPattern[i];
+			colorPattern[i] = colorPattern[j];
+			colorPattern[j] = color;
 		}
 	}
 	uint16_t	relativeWidth = inVertical ? 1 : inPatternLen;
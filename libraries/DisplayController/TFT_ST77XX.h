@@ -25,6 +25,21 @@
 #include <SPI.h>
 #include "DisplayController.h"
 
+/*
+*	When the SPI peripheral is the AVR SPI (SPDR is defined), pixel data is
+*	written by driving SPDR directly.  The next byte is loaded and byte
+*	swapped while the current byte is being shifted out, so the bus isn't
+*	idle between bytes while pixels are prepared.  Otherwise the pixels are
+*	byte swapped into a buffer that is then passed to SPI.transfer.
+*/
+#ifndef TFT_ST77XX_PIPELINED_SPI
+#ifdef SPDR
+#define TFT_ST77XX_PIPELINED_SPI	1
+#else
+#define TFT_ST77XX_PIPELINED_SPI	0
+#endif
+#endif
+
 class DataStream;
 
 class TFT_ST77XX : public DisplayController
@@ -116,6 +131,16 @@ public:
 
 	virtual void			SetAddressingMode(
 								EAddressingMode			inAddressingMode){}
+	/*
+	*	The controller scrolls its frame memory lines, so scrolling is only
+	*	vertical at rotations of 0 and 180.  At 90 and 270 SetScrollArea
+	*	returns false.
+	*/
+	virtual bool			SetScrollArea(
+								uint16_t				inFirstRow,
+								uint16_t				inRows);
+	virtual void			ScrollTo(
+								uint16_t				inOffset);
 protected:
 	enum ECmds
 	{
@@ -172,6 +197,12 @@ protected:
 							// When false the the display pixel origin is 0,0 at 0 degree rotation
 	bool		mResetLevel;// Allows the reset pin value to be inverted when run through an inverting level shifter.
 	bool		mInvColAddrOrder; // Set to reverse the col address order (for ILI9341)
+	uint8_t		mRotation;
+	bool		mRAMWRPending;		// SetColumnRange called, see WriteWindowCmds
+	uint16_t	mRowWindow[2];		// RASET start/end last written
+	uint16_t	mColumnWindow[2];	// CASET start/end last written
+	uint16_t	mNextRowWindow[2];	// Set by MoveToRow and SetRowRange
+	uint16_t	mNextColumnWindow[2];// Set by SetColumnRange
 	volatile port_t*	mChipSelPortReg;
 	volatile port_t*	mDCPortReg;
 	SPISettings	mSPISettings;
@@ -182,6 +213,8 @@ protected:
 	void					WriteWakeUpCmds(void);
 	void					SetRotation(
 								uint8_t					inRotation);
+	void					WriteWindowCmds(void);
+	void					InvalidateWindow(void);
 	inline void				BeginTransaction(void)
 							{
 								SPI.beginTransaction(mSPISettings);
@@ -223,6 +256,16 @@ protected:
 	void					WriteData16(
 								const uint16_t*			inData,
 								uint16_t				inDataLen) const;
+	void					WritePixels(
+								const uint16_t*			inPixels,
+								uint16_t				inPixelsLen) const;
+#if TFT_ST77XX_PIPELINED_SPI
+							// Waits for the byte being shifted out.
+	static inline void		WaitForSPI(void)
+							{
+								while (!(SPSR & _BV(SPIF)));
+							}
+#endif
 							// The native controller display resolution.
 	virtual uint16_t		VerticalRes(void) const = 0;
 	virtual uint16_t		HorizontalRes(void) const = 0;
@@ -0,0 +1,68 @@
+/*
+*	ArduinoSim.cpp, Copyright Jonathan Mackey 2023
+*	Host (desktop) stand-in for the Arduino core pin and timing functions.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#if defined(__MACH__) || defined(__linux__)
+#include "ArduinoSim.h"
+
+uint8_t gPortSim[kPortSimPorts];
+
+/********************************** pinMode ***********************************/
+void pinMode(
+	uint8_t	inPin,
+	uint8_t	inMode)
+{
+}
+
+/******************************** digitalWrite ********************************/
+void digitalWrite(
+	uint8_t	inPin,
+	uint8_t	inValue)
+{
+	volatile uint8_t*	portReg = portOutputRegister(digitalPinToPort(inPin));
+	if (inValue)
+	{
+		*portReg |= digitalPinToBitMask(inPin);
+	} else
+	{
+		*portReg &= ~digitalPinToBitMask(inPin);
+	}
+}
+
+/******************************** digitalRead *********************************/
+int digitalRead(
+	uint8_t	inPin)
+{
+	return((*portOutputRegister(digitalPinToPort(inPin)) & digitalPinToBitMask(inPin)) != 0);
+}
+
+/*********************************** delay ************************************/
+void delay(
+	uint32_t	inMilliseconds)
+{
+}
+
+/***************************** delayMicroseconds ******************************/
+void delayMicroseconds(
+	uint32_t	inMicroseconds)
+{
+}
+#endif // __MACH__ || __linux__
@@ -0,0 +1,98 @@
+/*
+*	ArduinoSim.h, Copyright Jonathan Mackey 2023
+*	Host (desktop) stand-in for the Arduino core pin and timing functions.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef ArduinoSim_h
+#define ArduinoSim_h
+
+#if defined(__MACH__) || defined(__linux__)
+#include <inttypes.h>
+#include <stddef.h>
+#include <string.h>
+#include "pgmspace_stub.h"
+#include "WireSim.h"	// micros, millis
+
+#ifndef pgm_read_byte
+#define pgm_read_byte(a)	pgm_read_byte_near(a)
+#endif
+#ifndef pgm_read_word
+#define pgm_read_word(a)	pgm_read_word_near(a)
+#endif
+#ifndef strcpy_P
+#define strcpy_P(d, s)		strcpy(d, s)
+#endif
+
+#define HIGH	1
+#define LOW		0
+#define INPUT	0
+#define OUTPUT	1
+#ifndef _BV
+#define _BV(bit)	(1 << (bit))
+#endif
+
+/*
+*	The pins are mapped to four 8 bit ports the same way the ATmega644PA
+*	Arduino core maps them, pin 0 is bit 0 of port 0 (PB0), pin 8 is bit 0 of
+*	port 1, and so on.  The drivers that write the port registers directly
+*	(via portOutputRegister) change the same simulated register as
+*	digitalWrite, so the pin state can be sampled by the simulated buses.
+*/
+static const uint8_t	kPortSimPorts = 4;
+static const uint8_t	SS = 4;	// PB4
+extern uint8_t gPortSim[kPortSimPorts];
+
+inline uint8_t digitalPinToPort(
+	uint8_t	inPin)
+{
+	return(inPin / 8);
+}
+
+inline uint8_t digitalPinToBitMask(
+	uint8_t	inPin)
+{
+	return(1 << (inPin & 7));
+}
+
+inline volatile uint8_t* portOutputRegister(
+	uint8_t	inPort)
+{
+	return(&gPortSim[inPort % kPortSimPorts]);
+}
+
+void pinMode(
+	uint8_t	inPin,
+	uint8_t	inMode);
+void digitalWrite(
+	uint8_t	inPin,
+	uint8_t	inValue);
+int digitalRead(
+	uint8_t	inPin);
+/*
+*	The delays don't advance the simulated bus time.  They're only called
+*	during initialization and would otherwise dominate the measurements.
+*/
+void delay(
+	uint32_t	inMilliseconds);
+void delayMicroseconds(
+	uint32_t	inMicroseconds);
+
+#endif // __MACH__ || __linux__
+#endif // ArduinoSim_h
@@ -0,0 +1,316 @@
+/*
+*	FrameBufferSim.cpp, Copyright Jonathan Mackey 2023
+*	Host (desktop) framebuffer display that counts SPI traffic.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#if defined(__MACH__) || defined(__linux__)
+#include "FrameBufferSim.h"
+#include "DataStream.h"
+#include <stdio.h>
+#include <string.h>
+
+/******************************* FrameBufferSim *******************************/
+FrameBufferSim::FrameBufferSim(
+	uint16_t	inRows,
+	uint16_t	inColumns)
+	: DisplayController(inRows, inColumns),
+	  mStartRow(0), mEndRow(inRows-1), mStartColumn(0), mEndColumn(inColumns-1),
+	  mRAMRow(0), mRAMColumn(0)
+{
+	mPixels = new uint16_t[(uint32_t)inRows * inColumns];
+	memset(mPixels, 0, (uint32_t)inRows * inColumns * sizeof(uint16_t));
+	ResetStats();
+}
+
+/****************************** ~FrameBufferSim *******************************/
+FrameBufferSim::~FrameBufferSim(void)
+{
+	delete [] mPixels;
+}
+
+/********************************* ResetStats *********************************/
+void FrameBufferSim::ResetStats(void)
+{
+	memset(&mStats, 0, sizeof(mStats));
+}
+
+/********************************** SPITime ***********************************/
+uint64_t FrameBufferSim::SPITime(
+	uint32_t	inSPIClock) const
+{
+	return(((uint64_t)(mStats.commands + mStats.dataBytes) * 8 * 1000000000) / inSPIClock);
+}
+
+/********************************** WriteCmd **********************************/
+void FrameBufferSim::WriteCmd(
+	uint8_t	inParamBytes)
+{
+	mStats.commands++;
+	mStats.dataBytes += inParamBytes;
+}
+
+/********************************* WritePixel *********************************/
+/*
+*	Writes at the RAM pointer then advances it within the window the same way
+*	the controller does.  Pixels outside of the display are counted but not
+*	stored.
+*/
+void FrameBufferSim::WritePixel(
+	uint16_t	inColor)
+{
+	if (mRAMRow < mRows &&
+		mRAMColumn < mColumns)
+	{
+		mPixels[(uint32_t)mRAMRow * mColumns + mRAMColumn] = inColor;
+	}
+	mStats.pixels++;
+	mStats.dataBytes += 2;
+	if (mRAMColumn < mEndColumn)
+	{
+		mRAMColumn++;
+	} else
+	{
+		mRAMColumn = mStartColumn;
+		mRAMRow = mRAMRow < mEndRow ? mRAMRow + 1 : mStartRow;
+	}
+}
+
+/*********************************** MoveTo ***********************************/
+void FrameBufferSim::MoveTo(
+	uint16_t	inRow,
+	uint16_t	inColumn)
+{
+	MoveToRow(inRow);
+	mColumn = inColumn;
+}
+
+/********************************* MoveToRow **********************************/
+void FrameBufferSim::MoveToRow(
+	uint16_t	inRow)
+{
+	mStats.transactions++;
+	WriteCmd(4);	// RASET
+	mStartRow = inRow;
+	mEndRow = mRows-1;
+	mRow = inRow;
+}
+
+/******************************* SetColumnRange *******************************/
+void FrameBufferSim::SetColumnRange(
+	uint16_t	inStartColumn,
+	uint16_t	inEndColumn)
+{
+	mStats.transactions++;
+	WriteCmd(4);	// CASET
+	WriteCmd(0);	// RAMWR
+	mStartColumn = inStartColumn;
+	mEndColumn = inEndColumn;
+	mRAMRow = mStartRow;
+	mRAMColumn = mStartColumn;
+}
+
+/******************************** SetRowRange *********************************/
+void FrameBufferSim::SetRowRange(
+	uint16_t	inStartRow,
+	uint16_t	inEndRow)
+{
+	mStats.transactions++;
+	WriteCmd(4);	// RASET
+	mStartRow = inStartRow;
+	mEndRow = inEndRow;
+}
+
+/********************************* FillPixels *********************************/
+void FrameBufferSim::FillPixels(
+	uint32_t	inPixelsToFill,
+	uint16_t	inFillColor)
+{
+	mStats.transactions++;
+	for (; inPixelsToFill; inPixelsToFill--)
+	{
+		WritePixel(inFillColor);
+	}
+}
+
+/********************************* StreamCopy *********************************/
+void FrameBufferSim::StreamCopy(
+	DataStream*	inDataStream,
+	uint16_t	inPixelsToCopy)
+{
+	mStats.transactions++;
+	uint16_t	buffer[96];
+	while (inPixelsToCopy)
+	{
+		uint16_t pixelsToWrite = inPixelsToCopy > 96 ? 96 : inPixelsToCopy;
+		inPixelsToCopy -= pixelsToWrite;
+		inDataStream->Read(pixelsToWrite, buffer);
+		for (uint16_t i = 0; i < pixelsToWrite; i++)
+		{
+			WritePixel(NativePixel(buffer[i]));
+		}
+	}
+}
+
+/********************************* CopyPixels *********************************/
+void FrameBufferSim::CopyPixels(
+	const void*	inPixels,
+	uint16_t	inPixelsToCopy)
+{
+	mStats.transactions++;
+	const uint16_t*	pixels = (const uint16_t*)inPixels;
+	for (; inPixelsToCopy; inPixelsToCopy--)
+	{
+		WritePixel(NativePixel(*(pixels++)));
+	}
+}
+
+/************************************ Hash ************************************/
+uint32_t FrameBufferSim::Hash(void) const
+{
+	uint32_t	hash = 2166136261U;
+	const uint8_t*	data = (const uint8_t*)mPixels;
+	const uint8_t*	dataEnd = &data[(uint32_t)mRows * mColumns * sizeof(uint16_t)];
+	for (; data < dataEnd; data++)
+	{
+		hash = (hash ^ *data) * 16777619U;
+	}
+	return(hash);
+}
+
+/********************************* PNGChunk ***********************************/
+/*
+*	Writes a PNG chunk: length, type, data, CRC32 of the type and data.
+*/
+static bool PNGChunk(
+	FILE*			inFile,
+	const char*		inType,
+	const uint8_t*	inData,
+	uint32_t		inLength)
+{
+	static uint32_t	sCRCTable[256];
+	if (sCRCTable[1] == 0)
+	{
+		for (uint32_t n = 0; n < 256; n++)
+		{
+			uint32_t	c = n;
+			for (uint8_t k = 0; k < 8; k++)
+			{
+				c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+			}
+			sCRCTable[n] = c;
+		}
+	}
+	uint8_t	header[8] = {(uint8_t)(inLength >> 24), (uint8_t)(inLength >> 16),
+						 (uint8_t)(inLength >> 8), (uint8_t)inLength};
+	memcpy(&header[4], inType, 4);
+	uint32_t	crc = 0xFFFFFFFFU;
+	for (uint8_t i = 4; i < 8; i++)
+	{
+		crc = sCRCTable[(crc ^ header[i]) & 0xFF] ^ (crc >> 8);
+	}
+	for (uint32_t i = 0; i < inLength; i++)
+	{
+		crc = sCRCTable[(crc ^ inData[i]) & 0xFF] ^ (crc >> 8);
+	}
+	crc ^= 0xFFFFFFFFU;
+	uint8_t	trailer[4] = {(uint8_t)(crc >> 24), (uint8_t)(crc >> 16),
+						  (uint8_t)(crc >> 8), (uint8_t)crc};
+	return(fwrite(header, 1, 8, inFile) == 8 &&
+		fwrite(inData, 1, inLength, inFile) == inLength &&
+		fwrite(trailer, 1, 4, inFile) == 4);
+}
+
+/********************************** WritePNG **********************************/
+/*
+*	The image data is stored using zlib stored (uncompressed) blocks so that
+*	no compression library is needed.
+*/
+bool FrameBufferSim::WritePNG(
+	const char*	inPath) const
+{
+	const uint32_t	kRowBytes = 1 + (uint32_t)mColumns * 3;	// filter byte + RGB
+	const uint32_t	kRawLength = kRowBytes * mRows;
+	const uint32_t	kMaxBlock = 65535;
+	uint32_t	numBlocks = (kRawLength + kMaxBlock - 1) / kMaxBlock;
+	uint32_t	idatLength = 2 + kRawLength + numBlocks * 5 + 4;
+	uint8_t*	raw = new uint8_t[kRawLength];
+	uint8_t*	idat = new uint8_t[idatLength];
+	uint8_t*	rawPtr = raw;
+	const uint16_t*	pixels = mPixels;
+	for (uint16_t row = 0; row < mRows; row++)
+	{
+		*(rawPtr++) = 0;	// No filter
+		for (uint16_t column = 0; column < mColumns; column++)
+		{
+			uint16_t	color = *(pixels++);
+			*(rawPtr++) = ((color >> 11) * 255 + 15) / 31;
+			*(rawPtr++) = (((color >> 5) & 0x3F) * 255 + 31) / 63;
+			*(rawPtr++) = ((color & 0x1F) * 255 + 15) / 31;
+		}
+	}
+	uint8_t*	idatPtr = idat;
+	*(idatPtr++) = 0x78;	// zlib header, 32K window, no compression
+	*(idatPtr++) = 0x01;
+	uint32_t	adlerA = 1;
+	uint32_t	adlerB = 0;
+	for (uint32_t offset = 0; offset < kRawLength; offset += kMaxBlock)
+	{
+		uint32_t	blockLength = kRawLength - offset > kMaxBlock ? kMaxBlock : kRawLength - offset;
+		*(idatPtr++) = (offset + blockLength) == kRawLength;	// BFINAL, stored
+		*(idatPtr++) = blockLength;
+		*(idatPtr++) = blockLength >> 8;
+		*(idatPtr++) = ~blockLength;
+		*(idatPtr++) = ~blockLength >> 8;
+		memcpy(idatPtr, &raw[offset], blockLength);
+		idatPtr += blockLength;
+		for (uint32_t i = 0; i < blockLength; i++)
+		{
+			adlerA = (adlerA + raw[offset + i]) % 65521;
+			adlerB = (adlerB + adlerA) % 65521;
+		}
+	}
+	uint32_t	adler = (adlerB << 16) | adlerA;
+	*(idatPtr++) = adler >> 24;
+	*(idatPtr++) = adler >> 16;
+	*(idatPtr++) = adler >> 8;
+	*(idatPtr++) = adler;
+
+	uint8_t	ihdr[13] = {0, 0, (uint8_t)(mColumns >> 8), (uint8_t)mColumns,
+						0, 0, (uint8_t)(mRows >> 8), (uint8_t)mRows,
+						8,	// bit depth
+						2,	// color type RGB
+						0, 0, 0};
+	static const uint8_t	kSignature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	FILE*	file = fopen(inPath, "wb");
+	bool	success = file != nullptr;
+	if (success)
+	{
+		success = fwrite(kSignature, 1, sizeof(kSignature), file) == sizeof(kSignature) &&
+			PNGChunk(file, "IHDR", ihdr, sizeof(ihdr)) &&
+			PNGChunk(file, "IDAT", idat, idatLength) &&
+			PNGChunk(file, "IEND", nullptr, 0);
+		success = fclose(file) == 0 && success;
+	}
+	delete [] raw;
+	delete [] idat;
+	return(success);
+}
+
+#endif // __MACH__ || __linux__
@@ -0,0 +1,124 @@
+/*
+*	FrameBufferSim.h, Copyright Jonathan Mackey 2023
+*	Host (desktop) framebuffer display that counts SPI traffic.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef FrameBufferSim_h
+#define FrameBufferSim_h
+
+#if defined(__MACH__) || defined(__linux__)
+#include "DisplayController.h"
+
+/*
+*	FrameBufferSim is a 16 bit (565) DisplayController that draws into a
+*	framebuffer in host memory.  It behaves as a TFT_ST77XX does: MoveToRow
+*	sends RASET, SetColumnRange sends CASET followed by RAMWR, and pixel data
+*	is written to the window set by the last RASET/CASET, wrapping within the
+*	window.  Every command, data byte, and transaction that a TFT_ST77XX would
+*	send over SPI is counted so that drawing code can be measured on the host.
+*
+*	Only horizontal addressing is supported (same as TFT_ST77XX.)
+*/
+class FrameBufferSim : public DisplayController
+{
+public:
+	struct SStats
+	{
+		uint32_t	commands;		// Command bytes (DC low)
+		uint32_t	dataBytes;		// Command parameter and pixel bytes
+		uint32_t	transactions;	// SPI transactions (CS low to high)
+		uint32_t	pixels;			// Pixels written
+	};
+							FrameBufferSim(
+								uint16_t				inRows,
+								uint16_t				inColumns);
+	virtual					~FrameBufferSim(void);
+	virtual void			MoveTo(
+								uint16_t				inRow,
+								uint16_t				inColumn);
+	virtual void			MoveToRow(
+								uint16_t				inRow);
+	virtual void			MoveToColumn(
+								uint16_t				inColumn)
+								{mColumn = inColumn;}
+	virtual void			Sleep(void){}
+	virtual void			WakeUp(void){}
+	virtual void			FillPixels(
+								uint32_t				inPixelsToFill,
+								uint16_t				inFillColor);
+	virtual void			SetColumnRange(
+								uint16_t				inStartColumn,
+								uint16_t				inEndColumn);
+	virtual void			SetRowRange(
+								uint16_t				inStartRow,
+								uint16_t				inEndRow);
+	virtual void			StreamCopy(
+								DataStream*				inDataStream,
+								uint16_t				inPixelsToCopy);
+	virtual void			CopyPixels(
+								const void*				inPixels,
+								uint16_t				inPixelsToCopy);
+	virtual void			SetAddressingMode(
+								EAddressingMode			inAddressingMode){}
+
+	const SStats&			Stats(void) const
+								{return(mStats);}
+	void					ResetStats(void);
+	/*
+	*	SPITime: Returns the time in nanoseconds to clock the counted bytes
+	*	at inSPIClock Hz.
+	*/
+	uint64_t				SPITime(
+								uint32_t				inSPIClock) const;
+	const uint16_t*			Pixels(void) const
+								{return(mPixels);}
+	uint16_t				GetPixel(
+								uint16_t				inRow,
+								uint16_t				inColumn) const
+								{return(mPixels[(uint32_t)inRow * mColumns + inColumn]);}
+	/*
+	*	Hash: FNV-1a hash of the framebuffer.  Used to compare frames.
+	*/
+	uint32_t				Hash(void) const;
+	/*
+	*	WritePNG: Writes the framebuffer as an uncompressed 24 bit PNG.
+	*/
+	bool					WritePNG(
+								const char*				inPath) const;
+protected:
+	uint16_t*	mPixels;
+	SStats		mStats;
+	// The window set by the last RASET and CASET
+	uint16_t	mStartRow;
+	uint16_t	mEndRow;
+	uint16_t	mStartColumn;
+	uint16_t	mEndColumn;
+	// The controller's RAM write pointer
+	uint16_t	mRAMRow;
+	uint16_t	mRAMColumn;
+
+	void					WriteCmd(
+								uint8_t					inParamBytes);
+	void					WritePixel(
+								uint16_t				inColor);
+};
+
+#endif // __MACH__ || __linux__
+#endif // FrameBufferSim_h
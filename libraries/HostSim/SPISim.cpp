@@ -0,0 +1,117 @@
+/*
+*	SPISim.cpp, Copyright Jonathan Mackey 2023
+*	Host (desktop) stand-in for the Arduino SPI library.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#if defined(__MACH__) || defined(__linux__)
+#include "SPISim.h"
+#include <string.h>
+
+SPIClassSim SPI;
+
+/******************************** SPIClassSim *********************************/
+SPIClassSim::SPIClassSim(void)
+	: mBusTime(0), mMaxClock(4000000), mClockPeriod(250)
+{
+	memset(mLastPorts, 0, sizeof(mLastPorts));
+	ResetStats();
+}
+
+/********************************* ResetStats *********************************/
+void SPIClassSim::ResetStats(void)
+{
+	mTransactions = 0;
+	mBytesTransferred = 0;
+	memset(mPinToggles, 0, sizeof(mPinToggles));
+}
+
+/********************************* SamplePins *********************************/
+void SPIClassSim::SamplePins(void)
+{
+	for (uint8_t port = 0; port < kPortSimPorts; port++)
+	{
+		uint8_t	changed = gPortSim[port] ^ mLastPorts[port];
+		if (changed)
+		{
+			mLastPorts[port] = gPortSim[port];
+			for (uint8_t bit = 0; bit < 8; bit++)
+			{
+				if (changed & (1 << bit))
+				{
+					mPinToggles[port*8 + bit]++;
+				}
+			}
+		}
+	}
+}
+
+/********************************* ClockBytes *********************************/
+void SPIClassSim::ClockBytes(
+	uint32_t	inBytes)
+{
+	SamplePins();
+	mBusTime += (uint64_t)mClockPeriod * inBytes * 8;
+	mBytesTransferred += inBytes;
+}
+
+/****************************** beginTransaction ******************************/
+void SPIClassSim::beginTransaction(
+	const SPISettings&	inSettings)
+{
+	SamplePins();
+	uint32_t	clock = inSettings.Clock() < mMaxClock ? inSettings.Clock() : mMaxClock;
+	mClockPeriod = 1000000000 / clock;
+	mTransactions++;
+}
+
+/******************************* endTransaction *******************************/
+void SPIClassSim::endTransaction(void)
+{
+	SamplePins();
+}
+
+/********************************** transfer **********************************/
+uint8_t SPIClassSim::transfer(
+	uint8_t	inData)
+{
+	ClockBytes(1);
+	return(0);
+}
+
+/********************************* transfer16 *********************************/
+uint16_t SPIClassSim::transfer16(
+	uint16_t	inData)
+{
+	ClockBytes(2);
+	return(0);
+}
+
+/********************************** transfer **********************************/
+/*
+*	As with SPIClass, the buffer is overwritten with the data received.
+*/
+void SPIClassSim::transfer(
+	void*	inBuffer,
+	size_t	inLength)
+{
+	ClockBytes(inLength);
+	memset(inBuffer, 0, inLength);
+}
+#endif // __MACH__ || __linux__
@@ -0,0 +1,115 @@
+/*
+*	SPISim.h, Copyright Jonathan Mackey 2023
+*	Host (desktop) stand-in for the Arduino SPI library.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef SPISim_h
+#define SPISim_h
+
+#if defined(__MACH__) || defined(__linux__)
+#include "ArduinoSim.h"
+
+#define MSBFIRST	1
+#define LSBFIRST	0
+#define SPI_MODE0	0x00
+#define SPI_MODE1	0x04
+#define SPI_MODE2	0x08
+#define SPI_MODE3	0x0C
+
+class SPISettings
+{
+public:
+							SPISettings(
+								uint32_t				inClock = 4000000,
+								uint8_t					inBitOrder = MSBFIRST,
+								uint8_t					inDataMode = SPI_MODE0)
+								: mClock(inClock){}
+	uint32_t				Clock(void) const
+								{return(mClock);}
+protected:
+	uint32_t	mClock;
+};
+
+/*
+*	SPIClassSim mimics the public interface of the Arduino SPIClass.  No data
+*	goes anywhere.  The bytes and transactions are counted, and the time it
+*	takes to clock the bytes at the transaction's clock (limited by the
+*	maximum clock of the MCU, F_CPU/2) is accumulated.
+*
+*	The simulated port registers (see ArduinoSim.h) are sampled at the start
+*	and end of each transaction and before each byte.  Each pin change seen
+*	is counted, e.g. the CS and DC toggles of a display driver.
+*/
+class SPIClassSim
+{
+public:
+	static const uint8_t	kPins = kPortSimPorts * 8;
+							SPIClassSim(void);
+	void					begin(void){}
+	void					end(void){}
+	void					beginTransaction(
+								const SPISettings&		inSettings);
+	void					endTransaction(void);
+	uint8_t					transfer(
+								uint8_t					inData);
+	uint16_t				transfer16(
+								uint16_t				inData);
+	void					transfer(
+								void*					inBuffer,
+								size_t					inLength);
+
+	/*
+	*	SetMaxClock: The fastest SPI clock of the MCU.  The default is 4MHz,
+	*	F_CPU/2 of an 8MHz ATmega644PA.
+	*/
+	void					SetMaxClock(
+								uint32_t				inMaxClock)
+								{mMaxClock = inMaxClock;}
+	/*
+	*	Simulated bus time in nanoseconds.
+	*/
+	uint64_t				BusTime(void) const
+								{return(mBusTime);}
+	uint32_t				Transactions(void) const
+								{return(mTransactions);}
+	uint32_t				BytesTransferred(void) const
+								{return(mBytesTransferred);}
+	uint32_t				PinToggles(
+								uint8_t					inPin) const
+								{return(inPin < kPins ? mPinToggles[inPin] : 0);}
+	void					ResetStats(void);
+protected:
+	uint64_t		mBusTime;
+	uint32_t		mMaxClock;
+	uint32_t		mClockPeriod;	// ns, of the current transaction
+	uint32_t		mTransactions;
+	uint32_t		mBytesTransferred;
+	uint32_t		mPinToggles[kPins];
+	uint8_t			mLastPorts[kPortSimPorts];
+
+	void					SamplePins(void);
+	void					ClockBytes(
+								uint32_t				inBytes);
+};
+
+extern SPIClassSim SPI;
+
+#endif // __MACH__ || __linux__
+#endif // SPISim_h
@@ -0,0 +1,179 @@
+/*
+*	WireSim.cpp, Copyright Jonathan Mackey 2023
+*	Host (desktop) stand-in for the Arduino Wire (TWI/I2C) library.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#if defined(__MACH__) || defined(__linux__)
+#include "WireSim.h"
+#include <string.h>
+
+TwoWireSim Wire;
+
+/********************************* TwoWireSim *********************************/
+/*
+*	mDevice isn't cleared here.  Wire is a global, so mDevice is zero
+*	initialized before any constructor runs.  Clearing it would drop devices
+*	attached by the constructors of globals in other files (e.g. AT24C) that
+*	happen to run before this one.
+*/
+TwoWireSim::TwoWireSim(void)
+	: mBusTime(0), mClockPeriod(10000), mTxAddress(0), mTxLength(0),
+	  mRxIndex(0), mRxLength(0)
+{
+	ResetStats();
+}
+
+/********************************** setClock **********************************/
+void TwoWireSim::setClock(
+	uint32_t	inClock)
+{
+	mClockPeriod = 1000000000 / inClock;
+}
+
+/********************************* ClockBytes *********************************/
+/*
+*	Each byte is 8 data bits plus the ack bit.  The start and stop conditions
+*	are counted as one clock each.
+*/
+void TwoWireSim::ClockBytes(
+	uint32_t	inBytes)
+{
+	mBusTime += (uint64_t)mClockPeriod * (inBytes * 9 + 2);
+	mBytesTransferred += inBytes;
+	mTransmissions++;
+}
+
+/********************************* ResetStats *********************************/
+void TwoWireSim::ResetStats(void)
+{
+	mTransmissions = 0;
+	mBytesTransferred = 0;
+	mNacks = 0;
+}
+
+/******************************** AttachDevice ********************************/
+void TwoWireSim::AttachDevice(
+	uint8_t			inAddress,
+	WireSimDevice*	inDevice)
+{
+	mDevice[inAddress & 0x7F] = inDevice;
+}
+
+/***************************** beginTransmission ******************************/
+void TwoWireSim::beginTransmission(
+	uint8_t	inAddress)
+{
+	mTxAddress = inAddress & 0x7F;
+	mTxLength = 0;
+}
+
+/*********************************** write ************************************/
+size_t TwoWireSim::write(
+	uint8_t	inData)
+{
+	if (mTxLength < kBufferLength)
+	{
+		mTxBuffer[mTxLength++] = inData;
+		return(1);
+	}
+	return(0);
+}
+
+/*********************************** write ************************************/
+size_t TwoWireSim::write(
+	const uint8_t*	inData,
+	size_t			inLength)
+{
+	size_t	bytesWritten = 0;
+	for (; bytesWritten < inLength; bytesWritten++)
+	{
+		if (!write(inData[bytesWritten]))
+		{
+			break;
+		}
+	}
+	return(bytesWritten);
+}
+
+/****************************** endTransmission *******************************/
+/*
+*	Returns the same status codes as TwoWire::endTransmission:
+*	0 = success, 2 = address NACK
+*/
+uint8_t TwoWireSim::endTransmission(
+	bool	inSendStop)
+{
+	WireSimDevice*	device = mDevice[mTxAddress];
+	if (!device ||
+		!device->Acknowledge(mBusTime))
+	{
+		ClockBytes(1);	// Just the address byte
+		mNacks++;
+		return(2);
+	}
+	ClockBytes(mTxLength + 1);
+	device->Receive(mTxBuffer, mTxLength, mBusTime);
+	mTxLength = 0;
+	return(0);
+}
+
+/******************************** requestFrom *********************************/
+uint8_t TwoWireSim::requestFrom(
+	uint8_t	inAddress,
+	uint8_t	inQuantity,
+	uint8_t	inSendStop)
+{
+	mRxIndex = 0;
+	mRxLength = 0;
+	WireSimDevice*	device = mDevice[inAddress & 0x7F];
+	if (!device ||
+		!device->Acknowledge(mBusTime))
+	{
+		ClockBytes(1);
+		mNacks++;
+		return(0);
+	}
+	if (inQuantity > kBufferLength)
+	{
+		inQuantity = kBufferLength;
+	}
+	mRxLength = device->Transmit(inQuantity, mRxBuffer, mBusTime);
+	ClockBytes(mRxLength + 1);
+	return(mRxLength);
+}
+
+/************************************ read ************************************/
+int TwoWireSim::read(void)
+{
+	return(mRxIndex < mRxLength ? mRxBuffer[mRxIndex++] : -1);
+}
+
+/*********************************** micros ***********************************/
+uint32_t micros(void)
+{
+	return((uint32_t)(Wire.BusTime() / 1000));
+}
+
+/*********************************** millis ***********************************/
+uint32_t millis(void)
+{
+	return((uint32_t)(Wire.BusTime() / 1000000));
+}
+#endif // __MACH__ || __linux__
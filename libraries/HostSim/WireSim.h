@@ -0,0 +1,137 @@
+/*
+*	WireSim.h, Copyright Jonathan Mackey 2023
+*	Host (desktop) stand-in for the Arduino Wire (TWI/I2C) library.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef WireSim_h
+#define WireSim_h
+
+#if defined(__MACH__) || defined(__linux__)
+#include <inttypes.h>
+#include <stddef.h>
+
+/*
+*	WireSimDevice is the interface a simulated I2C slave implements.  The bus
+*	calls the device once per transmission/request.  inBusTime is the
+*	simulated bus time in nanoseconds at the point the device is addressed.
+*/
+class WireSimDevice
+{
+public:
+	virtual					~WireSimDevice(void){}
+	/*
+	*	Return false to NACK the device address (e.g. while busy.)
+	*/
+	virtual bool			Acknowledge(
+								uint64_t				inBusTime) = 0;
+	/*
+	*	Master write.  Called from endTransmission with the bytes buffered
+	*	since beginTransmission.
+	*/
+	virtual void			Receive(
+								const uint8_t*			inData,
+								uint8_t					inLength,
+								uint64_t				inBusTime) = 0;
+	/*
+	*	Master read.  Called from requestFrom.  Returns the number of bytes
+	*	placed in outData.
+	*/
+	virtual uint8_t			Transmit(
+								uint8_t					inLength,
+								uint8_t*				outData,
+								uint64_t				inBusTime) = 0;
+};
+
+/*
+*	TwoWireSim mimics the public interface of the AVR TwoWire class closely
+*	enough that library code written against Wire compiles and runs unchanged
+*	on the host, including the 32 byte buffer limit.  The time it takes to
+*	clock each transaction onto the bus is accumulated as simulated bus time
+*	(9 clocks per byte plus start and stop.)  micros() returns this simulated
+*	time so polling loops such as AT24C::WaitTillReady behave as they do on
+*	the device.
+*/
+class TwoWireSim
+{
+public:
+	static const uint8_t	kBufferLength = 32;	// Same as TWI_BUFFER_LENGTH
+							TwoWireSim(void);
+	void					begin(void){}
+	void					setClock(
+								uint32_t				inClock);
+	void					beginTransmission(
+								uint8_t					inAddress);
+	uint8_t					endTransmission(
+								bool					inSendStop = true);
+	uint8_t					requestFrom(
+								uint8_t					inAddress,
+								uint8_t					inQuantity,
+								uint8_t					inSendStop = true);
+	size_t					write(
+								uint8_t					inData);
+	size_t					write(
+								const uint8_t*			inData,
+								size_t					inLength);
+	int						available(void)
+								{return(mRxLength - mRxIndex);}
+	int						read(void);
+
+	void					AttachDevice(
+								uint8_t					inAddress,
+								WireSimDevice*			inDevice);
+	/*
+	*	Simulated bus time in nanoseconds.
+	*/
+	uint64_t				BusTime(void) const
+								{return(mBusTime);}
+	void					AdvanceBusTime(
+								uint64_t				inNanoseconds)
+								{mBusTime += inNanoseconds;}
+	uint32_t				Transmissions(void) const
+								{return(mTransmissions);}
+	uint32_t				BytesTransferred(void) const
+								{return(mBytesTransferred);}
+	uint32_t				Nacks(void) const
+								{return(mNacks);}
+	void					ResetStats(void);
+protected:
+	WireSimDevice*	mDevice[128];
+	uint64_t		mBusTime;
+	uint32_t		mClockPeriod;	// ns
+	uint32_t		mTransmissions;
+	uint32_t		mBytesTransferred;
+	uint32_t		mNacks;
+	uint8_t			mTxAddress;
+	uint8_t			mTxLength;
+	uint8_t			mRxIndex;
+	uint8_t			mRxLength;
+	uint8_t			mTxBuffer[kBufferLength];
+	uint8_t			mRxBuffer[kBufferLength];
+
+	void					ClockBytes(
+								uint32_t				inBytes);
+};
+
+extern TwoWireSim Wire;
+uint32_t micros(void);
+uint32_t millis(void);
+
+#endif // __MACH__ || __linux__
+#endif // WireSim_h
@@ -37,6 +37,12 @@
 
 HikeLocations	HikeLocations::sInstance;
 
+#ifdef HIKE_LOC_CRC
+const uint16_t	kRecordSize = sizeof(SHikeLocationLink) + sizeof(uint16_t);
+#else
+const uint16_t	kRecordSize = sizeof(SHikeLocationLink);
+#endif
+
 /******************************** HikeLocations ********************************/
 HikeLocations::HikeLocations(void)
 	: mLocations(0), mCurrentIndex(0), mCount(0)
@@ -291,7 +297,7 @@ uint16_t HikeLocations::Add(
 	} else
 	{
 		mLocations->Seek(0, DataStream::eSeekEnd);
-		uint16_t	maxLocations = mLocations->GetPos()/sizeof(SHikeLocationLink)-1;
+		uint16_t	maxLocations = mLocations->GetPos()/kRecordSize-1;
 		if (maxLocations > mCount)
 		{
 			mCount++;
@@ -459,13 +465,52 @@ bool HikeLocations::IsValidIndex(
 	return(isValid);
 }
 
+/*********************************** Verify ***********************************/
+/*
+*	Verifies the root and every record that has been written, in use or on
+*	the free list, in a single sequential pass.
+*/
+uint16_t HikeLocations::Verify(void)
+{
+	uint16_t	failures = 0;
+#ifdef HIKE_LOC_CRC
+	if (mLocations)
+	{
+		mLocations->Seek(0, DataStream::eSeekEnd);
+		uint16_t	maxRecords = mLocations->GetPos()/kRecordSize;
+		uint16_t	records = mCount + 1;	// + 1 for the root
+		SHikeLocationRoot	root;
+		ReadLocation(0, &root);
+		SHikeLocationLink	link;
+		uint16_t	next = root.freeHead;
+		while (next && records < maxRecords)
+		{
+			ReadLocation(next, &link);
+			next = link.next;
+			records++;
+		}
+		mLocations->Seek(0, DataStream::eSeekSet);
+		failures = mLocations->VerifyCRC(sizeof(SHikeLocationLink), records);
+	}
+#endif
+	return(failures);
+}
+
 /******************************** ReadLocation ********************************/
 void HikeLocations::ReadLocation(
 	uint16_t		inIndex,
 	void*			inLocation) const
 {
-	mLocations->Seek(inIndex*sizeof(SHikeLocationLink), DataStream::eSeekSet);
+	mLocations->Seek(inIndex*kRecordSize, DataStream::eSeekSet);
+	/*
+	*	A record with a bad CRC is still returned.  Corrupt records are
+	*	reported by Verify.
+	*/
+#ifdef HIKE_LOC_CRC
+	mLocations->ReadCRC(sizeof(SHikeLocationLink), inLocation);
+#else
 	mLocations->Read(sizeof(SHikeLocationLink), inLocation);
+#endif
 }
 
 /******************************** WriteLocation *******************************/
@@ -473,8 +518,12 @@ void HikeLocations::WriteLocation(
 	uint16_t		inIndex,
 	const void*		inLocation) const
 {
-	mLocations->Seek(inIndex*sizeof(SHikeLocationLink), DataStream::eSeekSet);
+	mLocations->Seek(inIndex*kRecordSize, DataStream::eSeekSet);
+#ifdef HIKE_LOC_CRC
+	mLocations->WriteCRC(sizeof(SHikeLocationLink), inLocation);
+#else
 	mLocations->Write(sizeof(SHikeLocationLink), inLocation);
+#endif
 }
 
 #ifndef __MACH__
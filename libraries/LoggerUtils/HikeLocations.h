@@ -33,6 +33,14 @@
 
 class DataStream;
 
+/*
+*	When HIKE_LOC_CRC is defined each record on the locations data stream is
+*	followed by its CRC16.  The CRC isn't part of SHikeLocationLink so the
+*	radio packets are unaffected.  Changing this setting invalidates any
+*	existing location data (reload from SD.)
+*/
+//#define HIKE_LOC_CRC	1
+
 typedef struct
 {
 	uint16_t	elevation;	// Location elevation in feet.
@@ -113,6 +121,11 @@ public:
 	uint16_t				Add(
 								SHikeLocationLink&		inLocation);
 	bool					RemoveCurrent(void);
+							/*
+							*	Returns the number of corrupt records (always
+							*	0 when HIKE_LOC_CRC isn't defined.)
+							*/
+	uint16_t				Verify(void);
 #ifndef __MACH__
 	bool					LoadFromSD(void);
 	bool					SaveToSD(void);
@@ -30,6 +30,8 @@
 #include <string.h>
 #include "DataStream.h"
 #include "DisplayController.h"
+#include "XFontGlyphCache.h"
+#include "XFontRLE1BitDataStream.h"
 /*
 *	The font header, charcode runs array, and glyph data offsets array are
 *	assumed to be in near PROGMEM.  The Glyph data is accessed via a DataStream.
@@ -40,12 +42,14 @@
 */
 
 const uint16_t	XFont::kEllipsisCharcode = 0x2026;
+const uint16_t	XFont::kDegreeCharcode = 0x00B0;
 
 /*********************************** XFont ************************************/
 XFont::XFont(void)
-	: mDisplay(nullptr), mFontRows(0),
-	  mHighlightEnabled(false), mFont(nullptr),
-	  mTextColor(0xFFFF), mTextBGColor(0), mStartCol(0)
+	: mFont(nullptr), mDisplay(nullptr),
+	  mTextColor(0xFFFF), mTextBGColor(0), mStartCol(0), mFontRows(0),
+	  mHighlightEnabled(false), mSingleWindowMode(false),
+	  mGlyphCache(nullptr), mTextField(nullptr)
 {
 }
 
@@ -70,6 +74,11 @@ void XFont::SetFont(
 		if (inFont)
 		{
 			memcpy_P(&mFontHeader, mFont->header, sizeof(FontHeader));
+			if (mFont->asciiIndex &&
+				!mFont->asciiIndex->built)
+			{
+				BuildASCIIIndex();
+			}
 			if (mDisplay)
 			{
 				mFontRows = (mFontHeader.rotated == 0 || (mFontHeader.height & 7) == 0) ?
@@ -84,6 +93,24 @@ void XFont::SetFont(
 	}
 }
 
+/****************************** BuildASCIIIndex *******************************/
+/*
+*	Builds the ASCII index of the current font.  See Font::SetASCIIIndex.
+*/
+void XFont::BuildASCIIIndex(void)
+{
+	ASCIIIndex*	asciiIndex = mFont->asciiIndex;
+	for (uint8_t i = 0; i < 0x60; i++)
+	{
+		uint16_t	entryIndex = SearchCharcodeRuns(i + 0x20);
+		asciiIndex->index[i] = entryIndex == 0xFFFF ? kNoGlyph :
+								(entryIndex < kSearchRuns ? entryIndex : kSearchRuns);
+	}
+	asciiIndex->degreeIndex = SearchCharcodeRuns(kDegreeCharcode);
+	asciiIndex->ellipsisIndex = SearchCharcodeRuns(kEllipsisCharcode);
+	asciiIndex->built = true;
+}
+
 /********************************* FindGlyph **********************************/
 /*
 *	Returns entryIndex within the glyphDataOffsets for inCharcode.
@@ -91,6 +118,43 @@ void XFont::SetFont(
 */
 uint16_t XFont::FindGlyph(
 	uint16_t	inCharcode)
+{
+	uint16_t	entryIndex;
+	const ASCIIIndex*	asciiIndex = mFont->asciiIndex;
+	if (!asciiIndex ||
+		!asciiIndex->built)
+	{
+		entryIndex = SearchCharcodeRuns(inCharcode);
+	} else if (inCharcode >= 0x20 &&
+		inCharcode < 0x80 &&
+		asciiIndex->index[inCharcode - 0x20] != kSearchRuns)
+	{
+		entryIndex = asciiIndex->index[inCharcode - 0x20];
+		if (entryIndex == kNoGlyph)
+		{
+			entryIndex = 0xFFFF;
+		}
+	} else if (inCharcode == kDegreeCharcode)
+	{
+		entryIndex = asciiIndex->degreeIndex;
+	} else if (inCharcode == kEllipsisCharcode)
+	{
+		entryIndex = asciiIndex->ellipsisIndex;
+	} else
+	{
+		entryIndex = SearchCharcodeRuns(inCharcode);
+	}
+	return(entryIndex);
+}
+
+/***************************** SearchCharcodeRuns *****************************/
+/*
+*	Binary search of the charcode runs for inCharcode.
+*	Returns entryIndex within the glyphDataOffsets for inCharcode.
+*	0xFFFF is returned if the glyph doesn't exist.
+*/
+uint16_t XFont::SearchCharcodeRuns(
+	uint16_t	inCharcode) const
 {
 	uint16_t leftIndex = 0;
 	const CharcodeRun*	charcodeRuns = mFont->charcodeRuns;
@@ -157,13 +221,17 @@ bool XFont::LoadGlyphHeader(
 	bool	success = false;
 	if (inEntryIndex < mFontHeader.numCharCodes)
 	{
-		DataStream*	glyphData = mFont->glyphData;
+		/*
+		*	The header is read directly from the source stream.  The
+		*	XFontDataStream is only used to unpack the glyph data.
+		*/
+		DataStream*	glyphData = mFont->glyphData->GetSourceStream();
 		// At this point we have the entry index of the glyph within the GlyphDataOffsets
 		// Load the glyph header
-		success = glyphData->Seek(pgm_read_word_near(&mFont->glyphDataOffsets[inEntryIndex]), DataStream::eSeekSet);
+		success = glyphData->Seek(pgm_read_word_near(&mFont->glyphDataOffsets[inEntryIndex]), DataStream::eSeekSet) &&
+			glyphData->Read(sizeof(GlyphHeader), &mGlyph) == sizeof(GlyphHeader);
 		if (success)
 		{
-			glyphData->Read(sizeof(GlyphHeader), &mGlyph);
 			if (mGlyph.x < 0)
 			{
 				mGlyph.x = 0; 	// Kerning not supported
@@ -181,26 +249,48 @@ bool XFont::LoadGlyphHeader(
 
 /********************************* LoadGlyph **********************************/
 /*
-*	Seeks the DataStream mGlyphData to point to the glyph data for inCharcode.
-*	Returns true if the glyph was loaded.
-*	mGlyph is initialized from the stream.
+*	Loads the glyph header for inCharcode into mGlyph.
+*	Returns true if the glyph exists.
+*	When the font has a glyph header cache (see Font::SetGlyphHeaderCache)
+*	the cache is searched first.  When the cache is full the entries are
+*	replaced round robin.
 */
 bool XFont::LoadGlyph(
 	uint16_t	inCharcode)
 {
+	GlyphHeaderCacheEntry*	cacheEntry = mFont->glyphHeaderCache;
+	// A charcode of 0 would match the unused entries, so it isn't searched.
+	GlyphHeaderCacheEntry*	cacheEnd = &cacheEntry[inCharcode ? mFont->glyphHeaderCacheSize : 0];
+	for (; cacheEntry < cacheEnd; cacheEntry++)
+	{
+		if (cacheEntry->charcode != inCharcode)
+		{
+			continue;
+		}
+		mGlyph = cacheEntry->glyph;
+		mCharcode = inCharcode;
+		mCharcodeIndex = cacheEntry->entryIndex;
+		return(true);
+	}
 	bool	success = true;
-	uint16_t	entryIndex = mCharcode != inCharcode ? FindGlyph(inCharcode) : mCharcodeIndex;
-	/*
-	*	Note that LoadGlyphHeader needs to be called before each DrawCharcode
-	*	call because of a kluge in XFontDataStream::Read that uses the first
-	*	read as a flag to initialize state variables.  If this wasn't the case
-	*	then the loading could be skipped as an optimization. 
-	*/
+	uint16_t	entryIndex = FindGlyph(inCharcode);
 	if (entryIndex != 0xFFFF &&
 		LoadGlyphHeader(entryIndex))
 	{
 		mCharcode = inCharcode;
 		mCharcodeIndex = entryIndex;
+		if (mFont->glyphHeaderCacheSize)
+		{
+			cacheEntry = &mFont->glyphHeaderCache[mFont->nextHeaderCacheEntry];
+			cacheEntry->charcode = inCharcode;
+			cacheEntry->entryIndex = entryIndex;
+			cacheEntry->glyph = mGlyph;
+			mFont->nextHeaderCacheEntry++;
+			if (mFont->nextHeaderCacheEntry >= mFont->glyphHeaderCacheSize)
+			{
+				mFont->nextHeaderCacheEntry = 0;
+			}
+		}
 	} else
 	{
 		success = false;
@@ -208,6 +298,18 @@ bool XFont::LoadGlyph(
 	return(success);
 }
 
+/******************************* SeekGlyphData ********************************/
+/*
+*	Positions the glyph data stream at the data of the last glyph loaded by
+*	LoadGlyph, just past the glyph header.  Seeking also resets the stream's
+*	unpack state.
+*/
+bool XFont::SeekGlyphData(void)
+{
+	return(mFont->glyphData->Seek(pgm_read_word_near(
+		&mFont->glyphDataOffsets[mCharcodeIndex]) + sizeof(GlyphHeader), DataStream::eSeekSet));
+}
+
 /******************************** DrawCharcode ********************************/
 /*
 *	Draws a single glyph at the current display position.
@@ -219,6 +321,22 @@ bool XFont::DrawCharcode(
 	uint16_t	inCharcode,
 	uint8_t		inFakeMonospaceWidth)
 {
+	/*
+	*	If the glyph is cached AND
+	*	the entire glyph cell fits THEN
+	*	draw it from the cache.
+	*/
+	if (mGlyphCache &&
+		!inFakeMonospaceWidth &&
+		mDisplay->BitsPerPixel() == 16)
+	{
+		const GlyphHeaderCacheEntry*	cacheEntry = mGlyphCache->Find(mFont, inCharcode);
+		if (cacheEntry &&
+			mDisplay->WillFit(mFontRows, cacheEntry->glyph.advanceX))
+		{
+			return(DrawCachedGlyph(cacheEntry));
+		}
+	}
 	bool doContinue = LoadGlyph(inCharcode);
 	while (doContinue)
 	{
@@ -252,6 +370,11 @@ bool XFont::DrawCharcode(
 				doContinue = false;
 				break;	// rotated only supported by 1 bit displays
 		#endif
+			} else if (mFontHeader.runLength1Bit &&
+				mDisplay->BitsPerPixel() != 16)
+			{
+				doContinue = false;
+				break;	// run length encoded only supported by 16 bit displays
 			}
 		}
 		uint16_t	startColumn = mDisplay->GetColumn();
@@ -283,7 +406,14 @@ bool XFont::DrawCharcode(
 		{
 			mDisplay->SetAddressingMode(DisplayController::eVertical);
 		}
-		doContinue = mDisplay->StreamCopyBlock(mFont->glyphData, rows, columns);
+		/*
+		*	Run length encoded 1 bit data is decoded directly to fills and
+		*	copies rather than being expanded a pixel at a time.
+		*/
+		doContinue = SeekGlyphData() &&
+			(mFontHeader.runLength1Bit ?
+				((XFontRLE1BitDataStream*)mFont->glyphData)->CopyBlock(mDisplay, rows, columns) :
+				mDisplay->StreamCopyBlock(mFont->glyphData, rows, columns));
 		if (vertical)
 		{
 			mDisplay->SetAddressingMode(DisplayController::eHorizontal);
@@ -322,6 +452,67 @@ bool XFont::DrawCharcode(
 	return(doContinue);
 }
 	
+/****************************** DrawCachedGlyph *******************************/
+/*
+*	Draws the glyph cell (mFontRows x advanceX) of a glyph cached by an
+*	XFontGlyphCache using a single column range.  The 1 bit glyph data is
+*	expanded row by row to the text and background colors.
+*	The caller has already determined that the cell fits.
+*/
+bool XFont::DrawCachedGlyph(
+	const GlyphHeaderCacheEntry*	inCacheEntry)
+{
+	mGlyph = inCacheEntry->glyph;
+	mCharcode = inCacheEntry->charcode;
+	mCharcodeIndex = inCacheEntry->entryIndex;
+	const uint8_t*	glyphData = (const uint8_t*)&inCacheEntry[1];
+	uint8_t		dataByte = 0;
+	uint8_t		dataMask = 0;
+	uint8_t		glyphBottom = mGlyph.y + mGlyph.rows;
+	uint8_t		glyphRight = mGlyph.x + mGlyph.columns;
+	uint16_t	pixels[32];
+	uint8_t		pixelCount = 0;
+	uint16_t	textColor = DisplayController::NativePixel(mTextColor);
+	uint16_t	bgColor = DisplayController::NativePixel(mTextBGColor);
+	mDisplay->Cover(mDisplay->GetRow(), mDisplay->GetColumn(), mFontRows, mGlyph.advanceX);
+	mDisplay->SetColumnRange(mGlyph.advanceX);
+	for (uint8_t row = 0; row < mFontRows; row++)
+	{
+		bool	glyphRow = row >= mGlyph.y && row < glyphBottom;
+		for (uint8_t column = 0; column < mGlyph.advanceX; column++)
+		{
+			uint16_t	color = bgColor;
+			if (glyphRow &&
+				column >= mGlyph.x &&
+				column < glyphRight)
+			{
+				if (dataMask == 0)
+				{
+					dataByte = *(glyphData++);
+					dataMask = 0x80;
+				}
+				if (dataByte & dataMask)
+				{
+					color = textColor;
+				}
+				dataMask >>= 1;
+			}
+			pixels[pixelCount++] = color;
+			if (pixelCount == sizeof(pixels)/sizeof(uint16_t))
+			{
+				mDisplay->CopyPixels(pixels, pixelCount);
+				pixelCount = 0;
+			}
+		}
+	}
+	if (pixelCount)
+	{
+		mDisplay->CopyPixels(pixels, pixelCount);
+	}
+	mDisplay->MoveColumnBy(mGlyph.advanceX);
+	return(mDisplay->GetColumn() != 0);	// don't wrap
+}
+
 //#include <stdio.h>
 /********************************** DrawStr ***********************************/
 /*
@@ -347,6 +538,21 @@ void XFont::DrawStr(
 	{
 		inFakeMonospaceWidth = 0;
 	}
+	if (mTextField &&
+		DrawStrInField(inUTF8Str, inFakeMonospaceWidth, inCharacterLimit))
+	{
+		return;
+	}
+	if (mSingleWindowMode &&
+		DrawStrInWindow(inUTF8Str, inFakeMonospaceWidth, inCharacterLimit))
+	{
+		if (inClearTillEOL &&
+			mDisplay->GetColumn())
+		{
+			EraseTillEndOfLine();
+		}
+		return;
+	}
 	uint8_t	charactersDrawn = 0;
 	for (uint16_t charcode = NextChar(strPtr);
 			charcode && (inCharacterLimit == 0 || charactersDrawn < inCharacterLimit);
@@ -395,6 +601,253 @@ void XFont::DrawStr(
 	}
 }
 
+/******************************* DrawStrInField *******************************/
+/*
+*	Compares inUTF8Str with the glyphs last drawn into mTextField.  If the
+*	field is valid and the position of every glyph is unchanged, only the
+*	glyphs that differ are drawn and true is returned.  Otherwise
+*	mTextField is updated to reflect inUTF8Str and false is returned so that
+*	the caller draws the entire string.
+*/
+bool XFont::DrawStrInField(
+	const char*	inUTF8Str,
+	uint8_t		inFakeMonospaceWidth,
+	uint8_t		inCharacterLimit)
+{
+	TextField*	field = mTextField;
+	uint16_t	row = mDisplay->GetRow();
+	uint16_t	column = mDisplay->GetColumn();
+	bool	sameGlyphPositions = field->numGlyphs &&
+									field->font == mFont &&
+									field->row == row &&
+									field->column == column &&
+									field->textColor == mTextColor &&
+									field->bgColor == mTextBGColor;
+	uint16_t	charcode[TextField::kMaxGlyphs];
+	uint16_t	x = 0;
+	uint8_t		numGlyphs = 0;
+	bool	isValid = true;
+	{
+		const char*	strPtr = inUTF8Str;
+		for (uint16_t thisCharcode = NextChar(strPtr);
+				thisCharcode && (inCharacterLimit == 0 || numGlyphs < inCharacterLimit);
+					thisCharcode = NextChar(strPtr), numGlyphs++)
+		{
+			isValid = numGlyphs < TextField::kMaxGlyphs &&
+						thisCharcode >= ' ' &&
+						LoadGlyph(thisCharcode);
+			if (isValid)
+			{
+				if (sameGlyphPositions)
+				{
+					sameGlyphPositions = numGlyphs < field->numGlyphs &&
+											field->glyphX[numGlyphs] == x;
+				}
+				charcode[numGlyphs] = thisCharcode;
+				field->glyphX[numGlyphs] = x;
+				x += (inFakeMonospaceWidth ? inFakeMonospaceWidth : mGlyph.advanceX);
+				continue;
+			}
+			break;
+		}
+	}
+	sameGlyphPositions = sameGlyphPositions &&
+							isValid &&
+							numGlyphs == field->numGlyphs &&
+							field->glyphX[numGlyphs] == x;
+	if (sameGlyphPositions)
+	{
+		mStartCol = column;
+		for (uint8_t i = 0; i < numGlyphs; i++)
+		{
+			if (charcode[i] != field->charcode[i])
+			{
+				mDisplay->MoveTo(row, column + field->glyphX[i]);
+				DrawCharcode(charcode[i], inFakeMonospaceWidth);
+				field->charcode[i] = charcode[i];
+			}
+		}
+		mDisplay->MoveTo(row, column + x);
+	} else if (isValid &&
+		numGlyphs &&
+		mDisplay->WillFit(mFontRows, x))
+	{
+		field->font = mFont;
+		field->row = row;
+		field->column = column;
+		field->textColor = mTextColor;
+		field->bgColor = mTextBGColor;
+		field->numGlyphs = numGlyphs;
+		field->glyphX[numGlyphs] = x;
+		memcpy(field->charcode, charcode, numGlyphs * sizeof(uint16_t));
+	} else
+	{
+		field->numGlyphs = 0;
+	}
+	return(sameGlyphPositions);
+}
+
+/****************************** DrawStrInWindow *******************************/
+/*
+*	Draws a single line string as one or more windows.  See
+*	SetSingleWindowMode.  Returns false without drawing anything if the string
+*	can't be drawn this way, in which case the caller draws it a glyph at a
+*	time.
+*/
+bool XFont::DrawStrInWindow(
+	const char*	inUTF8Str,
+	uint8_t		inFakeMonospaceWidth,
+	uint8_t		inCharacterLimit)
+{
+	bool	success = mFontHeader.oneBit &&
+						!mFontHeader.rotated &&
+						!mFontHeader.runLength1Bit &&
+						mDisplay->BitsPerPixel() == 16;
+	uint16_t	numGlyphs = 0;
+	uint16_t	width = 0;
+	/*
+	*	Count the glyphs and measure the string.  Every glyph must fit in a
+	*	window by itself so that each window drawn below holds at least one.
+	*/
+	if (success)
+	{
+		const char*	strPtr = inUTF8Str;
+		for (uint16_t charcode = NextChar(strPtr);
+				charcode && (inCharacterLimit == 0 || numGlyphs < inCharacterLimit);
+					charcode = NextChar(strPtr), numGlyphs++)
+		{
+			success = charcode >= ' ' &&
+						LoadGlyph(charcode) &&
+						mGlyph.y >= 0 &&
+						(mGlyph.y + mGlyph.rows) <= mFontRows &&
+						(!inFakeMonospaceWidth || mGlyph.columns <= inFakeMonospaceWidth) &&
+						mGlyph.advanceX <= kMaxWindowColumns;
+			if (success)
+			{
+				width += (inFakeMonospaceWidth ? inFakeMonospaceWidth : mGlyph.advanceX);
+				continue;
+			}
+			break;
+		}
+		success = success &&
+					numGlyphs &&
+					mDisplay->WillFit(mFontRows, width);
+	}
+	if (success)
+	{
+		struct SGlyph
+		{
+			uint8_t			left;		// First column of the glyph within the window
+			int8_t			y;
+			uint8_t			rows;
+			uint8_t			columns;
+			const uint8_t*	cachedData;	// nullptr if not cached
+			uint16_t		dataOffset;	// Offset of the data within the source stream
+		} glyphs[kMaxWindowGlyphs];
+		DataStream*	glyphData = mFont->glyphData->GetSourceStream();
+		uint16_t	line[kMaxWindowColumns];
+		uint8_t		rowData[33];	// Enough for a 255 pixel row starting at any bit
+		uint16_t	textColor = DisplayController::NativePixel(mTextColor);
+		uint16_t	bgColor = DisplayController::NativePixel(mTextBGColor);
+		const char*	strPtr = inUTF8Str;
+		/*
+		*	A string wider than the line buffer or with more glyphs than
+		*	the layout holds is drawn as a run of windows, each ending on a
+		*	glyph boundary.  Glyphs don't overlap so the result is the same
+		*	as drawing the string as a single window.
+		*/
+		while (numGlyphs)
+		{
+			uint8_t	windowGlyphs = 0;
+			uint8_t	windowWidth = 0;
+			while (windowGlyphs < numGlyphs &&
+				windowGlyphs < kMaxWindowGlyphs)
+			{
+				const char*	nextStrPtr = strPtr;
+				uint16_t	charcode = NextChar(nextStrPtr);
+				LoadGlyph(charcode);
+				uint8_t	advance = inFakeMonospaceWidth ? inFakeMonospaceWidth : mGlyph.advanceX;
+				if (((uint16_t)windowWidth + advance) > kMaxWindowColumns)
+				{
+					break;
+				}
+				strPtr = nextStrPtr;
+				SGlyph&	glyph = glyphs[windowGlyphs];
+				glyph.y = mGlyph.y;
+				glyph.rows = mGlyph.rows;
+				glyph.columns = mGlyph.columns;
+				glyph.left = windowWidth + (inFakeMonospaceWidth ?
+					(inFakeMonospaceWidth - mGlyph.columns)/2 : mGlyph.x);
+				const GlyphHeaderCacheEntry*	cacheEntry = mGlyphCache ? mGlyphCache->Find(mFont, charcode) : nullptr;
+				if (cacheEntry)
+				{
+					glyph.cachedData = (const uint8_t*)&cacheEntry[1];
+				} else
+				{
+					glyph.cachedData = nullptr;
+					glyph.dataOffset = pgm_read_word_near(
+						&mFont->glyphDataOffsets[mCharcodeIndex]) + sizeof(GlyphHeader);
+				}
+				windowWidth += advance;
+				windowGlyphs++;
+			}
+			mDisplay->Cover(mDisplay->GetRow(), mDisplay->GetColumn(), mFontRows, windowWidth);
+			mDisplay->SetColumnRange(windowWidth);
+			for (uint8_t row = 0; row < mFontRows; row++)
+			{
+				/*
+				*	The line is filled with the background color and then the
+				*	foreground pixels of each glyph are set.
+				*/
+				for (uint8_t column = 0; column < windowWidth; column++)
+				{
+					line[column] = bgColor;
+				}
+				for (uint8_t i = 0; i < windowGlyphs; i++)
+				{
+					const SGlyph&	glyph = glyphs[i];
+					if (row >= glyph.y &&
+						row < (glyph.y + glyph.rows))
+					{
+						uint16_t		bitOffset = (uint16_t)(row - glyph.y) * glyph.columns;
+						const uint8_t*	data = glyph.cachedData;
+						if (data)
+						{
+							data += (bitOffset/8);
+						} else
+						{
+							glyphData->Seek(glyph.dataOffset + (bitOffset/8), DataStream::eSeekSet);
+							glyphData->Read((((bitOffset & 7) + glyph.columns + 7)/8), rowData);
+							data = rowData;
+						}
+						uint16_t*	linePtr = &line[glyph.left];
+						uint8_t	dataMask = 0x80 >> (bitOffset & 7);
+						uint8_t	dataByte = *(data++);
+						for (uint8_t glyphColumn = 0; glyphColumn < glyph.columns; glyphColumn++)
+						{
+							if (dataMask == 0)
+							{
+								dataByte = *(data++);
+								dataMask = 0x80;
+							}
+							if (dataByte & dataMask)
+							{
+								*linePtr = textColor;
+							}
+							linePtr++;
+							dataMask >>= 1;
+						}
+					}
+				}
+				mDisplay->CopyPixels(line, windowWidth);
+			}
+			mDisplay->MoveColumnBy(windowWidth);
+			numGlyphs -= windowGlyphs;
+		}
+	}
+	return(success);
+}
+
 /***************************** EraseTillEndOfLine *****************************/
 void XFont::EraseTillEndOfLine(void)
 {
@@ -839,8 +1292,53 @@ uint16_t XFont::Calc565Color(
 XFontDataStream::XFontDataStream(
 	XFont*		inXFont,
 	DataStream*	inSourceStream)
-	: mXFont(inXFont), mSourceStream(inSourceStream)
+	: mXFont(inXFont), mSourceStream(inSourceStream), mBufferPtr(nullptr),
+	  mBufferIndex(0), mBytesInBuffer(0), mAddressSpace(DataStream::eSRAM)
+{
+}
+
+/********************************* ResetState *********************************/
+/*
+*	Called by Seek.  Subclasses that override ResetState to reset their unpack
+*	state must call this base implementation to discard the buffered data.
+*/
+void XFontDataStream::ResetState(void)
 {
+	mBufferIndex = 0;
+	mBytesInBuffer = 0;
+}
+
+/********************************** NextByte **********************************/
+/*
+*	This routine manages a small buffer rather than constantly calling Read of
+*	the source stream.  For SRAM and PROGMEM sources the data is accessed in
+*	place rather than being copied to mBuffer.
+*/
+uint8_t XFontDataStream::NextByte(void)
+{
+	if (mBufferIndex == mBytesInBuffer)
+	{
+		uint8_t	bytes2Map = (uint8_t)mSourceStream->Clip(sizeof(mBuffer));
+		mBufferPtr = (const uint8_t*)mSourceStream->Map(bytes2Map, mBuffer, mAddressSpace);
+		mBytesInBuffer = mBufferPtr ? bytes2Map : 0;
+		mBufferIndex = 0;
+	}
+	if (mBytesInBuffer)
+	{
+		return(mAddressSpace == DataStream::ePROGMEM ?
+			pgm_read_byte_near(&mBufferPtr[mBufferIndex++]) : mBufferPtr[mBufferIndex++]);
+	}
+	return(0);
+}
+
+/*************************** FlushGlyphHeaderCache ****************************/
+void XFont::Font::FlushGlyphHeaderCache(void)
+{
+	for (uint8_t i = 0; i < glyphHeaderCacheSize; i++)
+	{
+		glyphHeaderCache[i].charcode = 0;
+	}
+	nextHeaderCacheEntry = 0;
 }
 
 /******************************** MakeCurrent *********************************/
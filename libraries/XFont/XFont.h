@@ -28,16 +28,43 @@
 #include "XFontDataStream.h"
 
 class DisplayController;
+class XFontGlyphCache;
 
 class XFont
 {
 public:
+	/*
+	*	A cached glyph header.  The header is stored after any adjustments
+	*	made by LoadGlyphHeader.  A charcode of 0 marks an unused entry.
+	*	Each entry uses 9 bytes of SRAM.
+	*/
+	struct GlyphHeaderCacheEntry
+	{
+		uint16_t			charcode;
+		uint16_t			entryIndex;
+		GlyphHeader			glyph;
+	};
+	/*
+	*	The glyph entry indexes of 0x20 to 0x7F plus the degree and ellipsis
+	*	glyphs.  Uses 101 bytes of SRAM.
+	*/
+	struct ASCIIIndex
+	{
+		uint8_t				index[0x60];	// Entry index of 0x20 to 0x7F
+		uint16_t			degreeIndex;
+		uint16_t			ellipsisIndex;
+		bool				built;
+	};
 	struct Font
 	{
 		const FontHeader*	header;
 		const CharcodeRun*	charcodeRuns;
 		const uint16_t*		glyphDataOffsets;
 		XFontDataStream*	glyphData;
+		GlyphHeaderCacheEntry*	glyphHeaderCache;	// nullptr if not cached
+		uint8_t				glyphHeaderCacheSize;
+		uint8_t				nextHeaderCacheEntry;	// Next entry to be replaced
+		ASCIIIndex*			asciiIndex;		// nullptr if not indexed
 							Font(
 								const FontHeader*	inHeader,
 								const CharcodeRun*	inCharcodeRuns,
@@ -46,11 +73,68 @@ public:
 								: header(inHeader),
 								  charcodeRuns(inCharcodeRuns),
 								  glyphDataOffsets(inGlyphDataOffsets),
-								  glyphData(inGlyphData){}
+								  glyphData(inGlyphData),
+								  glyphHeaderCache(nullptr), glyphHeaderCacheSize(0),
+								  asciiIndex(nullptr)
+								  {FlushGlyphHeaderCache();}
+		/*
+		*	The header cache only needs to be flushed if the glyph data changes.
+		*/
+		void				FlushGlyphHeaderCache(void);
+		/*
+		*	SetGlyphHeaderCache: The glyph headers of this font are cached in
+		*	the caller supplied inEntries.  The cache is searched linearly,
+		*	this is much quicker than the binary search of the charcode runs
+		*	followed by the seek and read of the glyph header.  No headers are
+		*	cached by default.  Pass nullptr to stop caching.
+		*/
+		void				SetGlyphHeaderCache(
+								GlyphHeaderCacheEntry*	inEntries,
+								uint8_t					inNumEntries)
+								{glyphHeaderCache = inEntries;
+								 glyphHeaderCacheSize = inEntries ? inNumEntries : 0;
+								 FlushGlyphHeaderCache();}
+		/*
+		*	SetASCIIIndex: inASCIIIndex is built by the next SetFont of this
+		*	font.  Looking up the indexed charcodes is then a single table
+		*	read rather than a binary search of the charcode runs.  Fonts
+		*	aren't indexed by default.  Pass nullptr to stop using the index.
+		*/
+		void				SetASCIIIndex(
+								ASCIIIndex*				inASCIIIndex)
+								{asciiIndex = inASCIIIndex;
+								 if (inASCIIIndex) inASCIIIndex->built = false;}
 								  
 		XFont*				GetXFont(void) const
 								{return(glyphData->GetXFont());}
 		XFont*				MakeCurrent(void);
+	};
+	/*
+	*	A TextField remembers the glyphs and their positions last drawn by
+	*	DrawStr into a field of the display.  See SetTextField.
+	*/
+	struct TextField
+	{
+		static const uint8_t	kMaxGlyphs = 8;
+		const Font*			font;
+		uint16_t			row;
+		uint16_t			column;
+		uint16_t			textColor;
+		uint16_t			bgColor;
+		uint8_t				numGlyphs;	// 0 = nothing remembered
+		uint16_t			charcode[kMaxGlyphs];
+		// glyphX[n] is the start of glyph n relative to column.
+		// glyphX[numGlyphs] is the width of the string.
+		uint16_t			glyphX[kMaxGlyphs+1];
+							TextField(void)
+								: numGlyphs(0){}
+		/*
+		*	Invalidate should be called whenever the field is erased or drawn
+		*	over by anything other than DrawStr.  The next draw is then a full
+		*	draw.
+		*/
+		void				Invalidate(void)
+								{numGlyphs = 0;}
 	};
 							XFont(void);
 
@@ -108,6 +192,37 @@ public:
 								uint8_t					inFakeMonospaceWidth = 0,
 								uint8_t					inCharacterLimit = 0);
 	/*
+	*	When the single window mode is enabled, DrawStr draws a single line
+	*	string as one window covering the string's bounding box.  The pixels
+	*	of each row of the string are composed in a line buffer and copied to
+	*	the display a row at a time.  This replaces the 4 or more windows per
+	*	glyph otherwise needed, at the cost of about 400 bytes of stack for
+	*	the line buffer (kMaxWindowColumns pixels) and the glyph layout
+	*	(kMaxWindowGlyphs glyphs.)  A string wider than kMaxWindowColumns or
+	*	with more than kMaxWindowGlyphs glyphs is drawn as several adjacent
+	*	windows.
+	*	Single window mode only applies to 1 bit unrotated, unencoded fonts on
+	*	16 bit displays.  Strings that contain control characters or that
+	*	don't fit on the display are drawn a glyph at a time.
+	*	The glyphs are placed exactly as they are when drawn a glyph at a
+	*	time, so the result and the widths returned by MeasureStr are the
+	*	same whichever way a string is drawn.
+	*/
+	void					SetSingleWindowMode(
+								bool					inSingleWindowMode)
+								{mSingleWindowMode = inSingleWindowMode;}
+	/*
+	*	SetTextField: While a text field is set, DrawStr (and therefore
+	*	DrawRightJustified, DrawCentered, and DrawAligned) only redraws the
+	*	glyphs that differ from those last drawn into inTextField.  A full
+	*	draw is done when the position, font, colors, or any glyph position
+	*	changes, or when the string contains control characters or more than
+	*	TextField::kMaxGlyphs glyphs.  Pass nullptr to stop using the field.
+	*/
+	void					SetTextField(
+								TextField*				inTextField)
+								{mTextField = inTextField;}
+	/*
 	*	DrawRightJustified draws the passed string from the right side of the
 	*	display, ignoring the display's current x position.  It's assumed there
 	*	is only a single line, no newlines in string.  If the passed string is
@@ -172,10 +287,16 @@ public:
 	void					DrawLoadedGlyph(void);
 	uint16_t				FindGlyph(
 								uint16_t				inCharcode);
+	/*
+	*	LoadGlyph loads the glyph header of inCharcode into mGlyph, from the
+	*	font's glyph cache when possible.  LoadGlyph doesn't position the glyph
+	*	data stream, SeekGlyphData does.
+	*/
 	bool					LoadGlyph(
 								uint16_t				inCharcode);
 	bool					LoadGlyphHeader(
 								uint16_t				inEntryIndex);
+	bool					SeekGlyphData(void);
 	bool					LoadFirstGlyph(
 								const char*				inUTF8Str);
 	/*
@@ -207,6 +328,15 @@ public:
 								{return(mGlyph);}
 	uint16_t				Charcode(void) const
 								{return(mCharcode);}
+	uint16_t				CharcodeIndex(void) const
+								{return(mCharcodeIndex);}
+	/*
+	*	SetGlyphCache: Glyphs found in inGlyphCache are drawn from the cache.
+	*	Pass nullptr to stop using the cache.  See XFontGlyphCache.h.
+	*/
+	void					SetGlyphCache(
+								XFontGlyphCache*		inGlyphCache)
+								{mGlyphCache = inGlyphCache;}
 	const FontHeader&		GetFontHeader(void) const
 								{return(mFontHeader);}
 	void					SetTextColor(
@@ -254,8 +384,30 @@ protected:
 	uint16_t			mCharcode;		// Currently loaded glyph charcode
 	uint16_t			mCharcodeIndex; // Currently loaded glyph index
 	bool				mHighlightEnabled;
+	bool				mSingleWindowMode;
 	uint8_t				mEllipsisWidth;	// 0 if current font has no ellipsis.
+	XFontGlyphCache*	mGlyphCache;
+	TextField*			mTextField;
 	static const uint16_t	kEllipsisCharcode;
+	static const uint16_t	kDegreeCharcode;
+	static const uint8_t	kMaxWindowColumns = 128;	// DrawStrInWindow line buffer
+	static const uint8_t	kMaxWindowGlyphs = 12;
+	static const uint8_t	kNoGlyph = 0xFF;		// asciiIndex, glyph doesn't exist
+	static const uint8_t	kSearchRuns = 0xFE;	// asciiIndex, entry index >= 0xFE
+	void					BuildASCIIIndex(void);
+	uint16_t				SearchCharcodeRuns(
+								uint16_t				inCharcode) const;
+
+	bool					DrawCachedGlyph(
+								const GlyphHeaderCacheEntry*	inCacheEntry);
+	bool					DrawStrInField(
+								const char*				inUTF8Str,
+								uint8_t					inFakeMonospaceWidth,
+								uint8_t					inCharacterLimit);
+	bool					DrawStrInWindow(
+								const char*				inUTF8Str,
+								uint8_t					inFakeMonospaceWidth,
+								uint8_t					inCharacterLimit);
 };
 
 #endif // XFont_h
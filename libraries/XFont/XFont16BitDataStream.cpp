@@ -23,6 +23,7 @@
 */
 #include "XFont16BitDataStream.h"
 #include "XFont.h"
+#include "DisplayController.h"
 #include <string.h>
 
 /*************************** XFont16BitDataStream *****************************/
@@ -30,6 +31,9 @@ XFont16BitDataStream::XFont16BitDataStream(
 	XFont*		inXFont,
 	DataStream*	inSourceStream)
 	: XFontDataStream(inXFont, inSourceStream)
+#if XFONT_TINT_LEVELS
+	  , mPaletteValid(false)
+#endif
 {
 }
 
@@ -38,11 +42,17 @@ bool XFont16BitDataStream::Seek(
 	int32_t		inOffset,
 	EOrigin		inOrigin)
 {
-	// Calling Seek flags the state data as waiting for the glyph header Read.
-	mReadGlyphHeader = true;
+	ResetState();
 	return(mSourceStream->Seek(inOffset, inOrigin));
 }
 
+/********************************* ResetState *********************************/
+void XFont16BitDataStream::ResetState(void)
+{
+	XFontDataStream::ResetState();
+	mSavedState.run = {0};
+}
+
 /*********************************** AtEOF ************************************/
 bool XFont16BitDataStream::AtEOF(void) const
 {
@@ -62,23 +72,42 @@ uint32_t XFont16BitDataStream::Clip(
 	return(mSourceStream->Clip(inLength));
 }
 
-/********************************** NextByte **********************************/
-/*
-*	This routine manages a small buffer rather than constantly calling Read of
-*	the source stream.
-*/
-uint8_t XFont16BitDataStream::NextByte(void)
+#if XFONT_TINT_LEVELS
+/******************************* UpdatePalette ********************************/
+void XFont16BitDataStream::UpdatePalette(void)
 {
-	if (mBufferIndex == mBytesInBuffer)
-	{
-		mBytesInBuffer = (uint8_t)mSourceStream->Read(sizeof(mBuffer), mBuffer);
-		mBufferIndex = 0;
-	}
-	if (mBytesInBuffer)
+	uint16_t	fgColor = mXFont->GetTextColor();
+	uint16_t	bgColor = mXFont->GetBGTextColor();
+	if (!mPaletteValid ||
+		fgColor != mPaletteFG ||
+		bgColor != mPaletteBG)
 	{
-		return(mBuffer[mBufferIndex++]);
+		mPaletteValid = true;
+		mPaletteFG = fgColor;
+		mPaletteBG = bgColor;
+		const uint8_t	kMaxLevel = XFONT_TINT_LEVELS - 1;
+		for (uint8_t level = 0; level <= kMaxLevel; level++)
+		{
+			mPalette[level] = DisplayController::NativePixel(
+								DisplayController::Calc565Color(fgColor, bgColor,
+								((uint16_t)level * 255 + kMaxLevel/2) / kMaxLevel));
+		}
 	}
-	return(0);
+}
+#endif
+
+/******************************** TintToColor *********************************/
+/*
+*	Tints 0 and 255 always map to the background and text colors.
+*/
+inline uint16_t XFont16BitDataStream::TintToColor(
+	uint8_t	inTint)
+{
+#if XFONT_TINT_LEVELS
+	return(mPalette[((uint16_t)inTint * (XFONT_TINT_LEVELS - 1) + 128) >> 8]);
+#else
+	return(DisplayController::NativePixel(mXFont->Calc565Color(inTint)));
+#endif
 }
 
 /************************************ Read ************************************/
@@ -90,20 +119,14 @@ uint32_t XFont16BitDataStream::Read(
 	uint32_t	inLength,
 	void*		outBuffer)
 {
-	if (mReadGlyphHeader)
-	{
-		mReadGlyphHeader = false;
-		mBufferIndex = 0;
-		mBytesInBuffer = 0;
-		mSavedState.run = {0};
-		return(mSourceStream->Read(inLength, outBuffer));
-	}
 	if (inLength)
 	{
 		uint16_t*	oBufferPtr = (uint16_t*)outBuffer;
 		uint16_t*	oBufferEnd = &oBufferPtr[inLength];
 		if (mXFont->GetFontHeader().oneBit)
 		{
+			uint16_t	textColor = DisplayController::NativePixel(mXFont->GetTextColor());
+			uint16_t	bgColor = DisplayController::NativePixel(mXFont->GetBGTextColor());
 			uint8_t	byteIn;
 			int8_t	bitsInByteIn = mSavedState.oneBit.bitsInByteIn;
 
@@ -126,7 +149,7 @@ uint32_t XFont16BitDataStream::Read(
 			{
 				for (; oBufferPtr != oBufferEnd && bitsInByteIn; byteIn <<= 1, bitsInByteIn--)
 				{
-					*(oBufferPtr++) = (byteIn & 0x80) ? mXFont->GetTextColor() : mXFont->GetBGTextColor();
+					*(oBufferPtr++) = (byteIn & 0x80) ? textColor : bgColor;
 				}
 				/*
 				*	If not at the end of the output buffer THEN
@@ -148,12 +171,15 @@ uint32_t XFont16BitDataStream::Read(
 			} while (true);
 		} else
 		{
+		#if XFONT_TINT_LEVELS
+			UpdatePalette();
+		#endif
 			int8_t runLength = mSavedState.run.length;
 			uint16_t	runColor;
 			if (runLength == 0)
 			{
 				runLength = NextByte();
-				runColor = mXFont->Calc565Color(NextByte());
+				runColor = TintToColor(NextByte());
 			} else
 			{
 				runColor = mSavedState.run.color;
@@ -172,7 +198,7 @@ uint32_t XFont16BitDataStream::Read(
 						runLength++;
 						if (runLength)
 						{
-							runColor = mXFont->Calc565Color(NextByte());
+							runColor = TintToColor(NextByte());
 							continue;
 						}
 						break;
@@ -198,7 +224,7 @@ uint32_t XFont16BitDataStream::Read(
 				if (oBufferPtr != oBufferEnd)
 				{
 					runLength = NextByte();
-					runColor = mXFont->Calc565Color(NextByte());
+					runColor = TintToColor(NextByte());
 				/*
 				*	else, save the state and exit.
 				*/
@@ -25,6 +25,16 @@
 
 #include "XFontDataStream.h"
 
+/*
+*	The number of colors in the tint palette used to expand 8 bit
+*	(antialiased) data.  Each tint is rounded to the nearest level rather than
+*	being blended per pixel.  16 or 32 is recommended, each level uses 2 bytes
+*	of SRAM.  Define as 0 to blend each tint exactly.
+*/
+#ifndef XFONT_TINT_LEVELS
+#define XFONT_TINT_LEVELS	16
+#endif
+
 class XFont16BitDataStream : public XFontDataStream
 {
 public:
@@ -46,10 +56,23 @@ public:
 	virtual bool			AtEOF(void) const;
 	virtual uint32_t		Clip(
 								uint32_t				inLength) const;
+	virtual void			ResetState(void);
 protected:
 	bool		mOneBit;
-	bool		mReadGlyphHeader;
-	
+#if XFONT_TINT_LEVELS
+	/*
+	*	The palette is rebuilt whenever the text or background color differs
+	*	from the colors it was built from.
+	*/
+	bool		mPaletteValid;
+	uint16_t	mPaletteFG;
+	uint16_t	mPaletteBG;
+	uint16_t	mPalette[XFONT_TINT_LEVELS];
+
+	void					UpdatePalette(void);
+#endif
+	inline uint16_t			TintToColor(
+								uint8_t					inTint);
 	// State data
 	union
 	{
@@ -65,10 +88,5 @@ protected:
 		} run;
 	} mSavedState;
 
-	uint8_t		mBuffer[32];
-	uint8_t		mBufferIndex;
-	uint8_t		mBytesInBuffer;
-	
-	uint8_t					NextByte(void);
 };
 #endif // XFont16BitDataStream_h
@@ -36,8 +36,26 @@ public:
 								{return(mXFont);}
 	DataStream*				GetSourceStream(void)
 								{return(mSourceStream);}
+	/*
+	*	ResetState discards any buffered data and partially unpacked state.
+	*	It's called whenever the stream is repositioned.
+	*/
+	virtual void			ResetState(void);
 protected:
-	XFont*		mXFont;
-	DataStream*	mSourceStream;
+	XFont*			mXFont;
+	DataStream*		mSourceStream;
+	/*
+	*	The source data is consumed in chunks of up to sizeof(mBuffer).
+	*	mBufferPtr points to the current chunk.  When the source stream can be
+	*	mapped it points directly into the source data, otherwise it points to
+	*	mBuffer.
+	*/
+	const uint8_t*	mBufferPtr;
+	uint8_t			mBuffer[32];
+	uint8_t			mBufferIndex;
+	uint8_t			mBytesInBuffer;
+	uint8_t			mAddressSpace;
+
+	uint8_t					NextByte(void);
 };
 #endif // XFontDataStream_h
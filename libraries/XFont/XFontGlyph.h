@@ -50,6 +50,13 @@ struct FontHeader
 	uint8_t		width;			// widest glyph within subset in pixels
 	uint16_t	numCharcodeRuns;// size of the CharcodeRuns array
 	uint16_t	numCharCodes;	// size of the GlyphDataOffsets array.
+	/*
+	*	Field added after the bit field above was full.  Font headers created
+	*	before this field existed should be regenerated by XFontSubset (or
+	*	edited) to initialize it to zero, otherwise -Wextra reports the
+	*	missing initializer.
+	*/
+	uint8_t		runLength1Bit;	// 1 bit data is run length encoded (applies to 1 bit, not rotated)
 };
 
 /*
@@ -123,6 +130,18 @@ struct GlyphHeader
 *			The same packing takes place for rotated, it's just columns rather
 *			than rows.
 *
+*	Run length encoded 1 bit data (FontHeader.runLength1Bit): Each byte holds
+*	a pair of runs, the high nibble is a run of background pixels and the low
+*	nibble is the run of foreground pixels that follows it.  Pixels are scanned
+*	the same as unencoded 1 bit data and the runs don't break at the end of
+*	each row.  A run longer than 15 pixels continues in the next byte paired
+*	with an empty run of the other color.  A zero byte is invalid.
+*
+*	Example: 20 background pixels followed by 3 foreground pixels would be
+*			encoded as 0xF0 0x53.
+*	The data must be read using an XFontRLE1BitDataStream and can only be
+*	drawn on 16 bit displays.
+*
 *	Meaning of the FontHeader.vertical flag:
 *	The vertical flag controls whether the rotated and packed data is stored
 *	as horizontal or vertical strips.	Horizontal: 123		Vertical:	147
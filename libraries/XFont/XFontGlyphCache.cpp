@@ -0,0 +1,103 @@
+/*
+*	XFontGlyphCache.cpp, Copyright Jonathan Mackey 2023
+*	Cache of unpacked glyphs for frequently drawn characters.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#include "XFontGlyphCache.h"
+#include "DataStream.h"
+
+/****************************** XFontGlyphCache *******************************/
+XFontGlyphCache::XFontGlyphCache(
+	uint8_t*	inBuffer,
+	uint16_t	inBufferSize)
+	: mFont(nullptr), mBuffer(inBuffer), mBufferSize(inBufferSize),
+	  mBytesUsed(0)
+{
+}
+
+/************************************ Load ************************************/
+bool XFontGlyphCache::Load(
+	XFont*		inXFont,
+	const char*	inUTF8Chars)
+{
+	XFont::Font*	font = inXFont->GetFont();
+	bool	success = font != nullptr &&
+						inXFont->GetFontHeader().oneBit &&
+						!inXFont->GetFontHeader().rotated &&
+						!inXFont->GetFontHeader().runLength1Bit;
+	mFont = font;
+	mBytesUsed = 0;
+	if (success)
+	{
+		DataStream*	glyphData = font->glyphData->GetSourceStream();
+		for (uint16_t charcode = XFont::NextChar(inUTF8Chars); charcode;
+								charcode = XFont::NextChar(inUTF8Chars))
+		{
+			success = inXFont->LoadGlyph(charcode);
+			if (success)
+			{
+				const GlyphHeader&	glyph = inXFont->Glyph();
+				uint16_t	dataSize = GlyphDataSize(glyph);
+				success = (mBytesUsed + EntrySize(glyph)) <= mBufferSize &&
+							inXFont->SeekGlyphData();
+				if (success)
+				{
+					XFont::GlyphHeaderCacheEntry*	cacheEntry = (XFont::GlyphHeaderCacheEntry*)&mBuffer[mBytesUsed];
+					success = glyphData->Read(dataSize, &cacheEntry[1]) == dataSize;
+					if (success)
+					{
+						cacheEntry->charcode = charcode;
+						cacheEntry->entryIndex = inXFont->CharcodeIndex();
+						cacheEntry->glyph = glyph;
+						mBytesUsed += EntrySize(glyph);
+						continue;
+					}
+				}
+			}
+			break;
+		}
+	}
+	return(success);
+}
+
+/************************************ Find ************************************/
+const XFont::GlyphHeaderCacheEntry* XFontGlyphCache::Find(
+	const XFont::Font*	inFont,
+	uint16_t			inCharcode) const
+{
+	const XFont::GlyphHeaderCacheEntry*	cacheEntry = nullptr;
+	if (inFont == mFont)
+	{
+		const uint8_t*	bufferPtr = mBuffer;
+		const uint8_t*	bufferEnd = &mBuffer[mBytesUsed];
+		while (bufferPtr < bufferEnd)
+		{
+			cacheEntry = (const XFont::GlyphHeaderCacheEntry*)bufferPtr;
+			if (cacheEntry->charcode != inCharcode)
+			{
+				bufferPtr += EntrySize(cacheEntry->glyph);
+				cacheEntry = nullptr;
+				continue;
+			}
+			break;
+		}
+	}
+	return(cacheEntry);
+}
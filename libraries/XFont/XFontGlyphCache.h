@@ -0,0 +1,79 @@
+/*
+*	XFontGlyphCache.h, Copyright Jonathan Mackey 2023
+*	Cache of unpacked glyphs for frequently drawn characters.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef XFontGlyphCache_h
+#define XFontGlyphCache_h
+
+#include "XFont.h"
+
+/*
+*	XFontGlyphCache holds the glyphs of a chosen set of characters of one
+*	font in a caller supplied SRAM buffer.  The size of the buffer is the RAM
+*	budget.  Each glyph is stored as an XFont::GlyphHeaderCacheEntry followed by the
+*	glyph's packed 1 bit data.  On 16 bit displays XFont draws a cached glyph
+*	as a single window covering the entire glyph cell (the padding and the
+*	advance included), rather than the series of FillBlock and
+*	StreamCopyBlock calls used for uncached glyphs.
+*
+*	Only one bit, unrotated, unencoded fonts are supported.  A fully expanded
+*	16 bit cell of a 36pt digit is about 1.5KB, too large to cache on a 4KB
+*	MCU.
+*	The 1 bit data is expanded as it's sent to the display.
+*/
+class XFontGlyphCache
+{
+public:
+							XFontGlyphCache(
+								uint8_t*				inBuffer,
+								uint16_t				inBufferSize);
+	/*
+	*	Load replaces the contents of the cache with the glyphs of the
+	*	characters in inUTF8Chars using the current font of inXFont.
+	*	Returns false if any of the glyphs don't exist or don't fit within the
+	*	buffer.  The glyphs that fit are still cached.
+	*/
+	bool					Load(
+								XFont*					inXFont,
+								const char*				inUTF8Chars);
+	/*
+	*	Returns the cached entry for inCharcode of inFont, else nullptr.
+	*/
+	const XFont::GlyphHeaderCacheEntry* Find(
+								const XFont::Font*		inFont,
+								uint16_t				inCharcode) const;
+	uint16_t				BytesUsed(void) const
+								{return(mBytesUsed);}
+	static uint16_t			GlyphDataSize(
+								const GlyphHeader&		inGlyph)
+								{return((((uint16_t)inGlyph.rows * inGlyph.columns) + 7)/8);}
+	// Entries are kept 16 bit aligned for the non-AVR MCUs.
+	static uint16_t			EntrySize(
+								const GlyphHeader&		inGlyph)
+								{return((sizeof(XFont::GlyphHeaderCacheEntry) + GlyphDataSize(inGlyph) + 1) & ~1);}
+protected:
+	const XFont::Font*	mFont;
+	uint8_t*			mBuffer;
+	uint16_t			mBufferSize;
+	uint16_t			mBytesUsed;
+};
+
+#endif // XFontGlyphCache_h
@@ -47,18 +47,12 @@ public:
 	virtual bool			AtEOF(void) const;
 	virtual uint32_t		Clip(
 								uint32_t				inLength) const;
+	virtual void			ResetState(void);
 protected:
-	bool		mReadGlyphHeader;
-	
 	// State data
 	uint8_t		mBitsInByteIn;
 	uint8_t		mByteIn;
 	uint8_t		mBitsInColumn;
 
-	uint8_t		mBuffer[32];
-	uint8_t		mBufferIndex;
-	uint8_t		mBytesInBuffer;
-	
-	uint8_t					NextByte(void);
 };
 #endif // XFontR1BitDataStream_h
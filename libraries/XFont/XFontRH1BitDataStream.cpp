@@ -38,11 +38,19 @@ bool XFontRH1BitDataStream::Seek(
 	int32_t		inOffset,
 	EOrigin		inOrigin)
 {
-	// Calling Seek flags the state data as waiting for the glyph header Read.
-	mReadGlyphHeader = true;
+	ResetState();
 	return(mSourceStream->Seek(inOffset, inOrigin));
 }
 
+/********************************* ResetState *********************************/
+void XFontRH1BitDataStream::ResetState(void)
+{
+	XFontDataStream::ResetState();
+	mBitsInByteIn = 0;
+	mBitsInRowColumn = 0;
+	mColumnsLeftInRow = 0;
+}
+
 /*********************************** AtEOF ************************************/
 bool XFontRH1BitDataStream::AtEOF(void) const
 {
@@ -62,25 +70,6 @@ uint32_t XFontRH1BitDataStream::Clip(
 	return(mSourceStream->Clip(inLength));
 }
 
-/********************************** NextByte **********************************/
-/*
-*	This routine manages a small buffer rather than constantly calling Read of
-*	the source stream.
-*/
-uint8_t XFontRH1BitDataStream::NextByte(void)
-{
-	if (mBufferIndex == mBytesInBuffer)
-	{
-		mBytesInBuffer = (uint8_t)mSourceStream->Read(sizeof(mBuffer), mBuffer);
-		mBufferIndex = 0;
-	}
-	if (mBytesInBuffer)
-	{
-		return(mBuffer[mBufferIndex++]);
-	}
-	return(0);
-}
-
 #if 0
 #ifdef __MACH__
 #include <string>
@@ -124,16 +113,6 @@ uint32_t XFontRH1BitDataStream::Read(
 	uint32_t	inLength,
 	void*		outBuffer)
 {
-	if (mReadGlyphHeader)
-	{
-		mReadGlyphHeader = false;
-		mBufferIndex = 0;
-		mBytesInBuffer = 0;
-		mBitsInByteIn = 0;
-		mBitsInRowColumn = 0;
-		mColumnsLeftInRow = 0;
-		return(mSourceStream->Read(inLength, outBuffer));
-	}
 	if (inLength)
 	{
 		uint8_t		offsetBitsBy = mXFont->Glyph().y;
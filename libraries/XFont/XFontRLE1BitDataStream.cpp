@@ -0,0 +1,265 @@
+/*
+*	XFontRLE1BitDataStream.cpp, Copyright Jonathan Mackey 2023
+*	Class that decodes run length encoded 1 bit data for 16 bit displays.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#include "XFontRLE1BitDataStream.h"
+#include "XFont.h"
+#include "DisplayController.h"
+#include <string.h>
+
+/*************************** XFontRLE1BitDataStream ***************************/
+XFontRLE1BitDataStream::XFontRLE1BitDataStream(
+	XFont*		inXFont,
+	DataStream*	inSourceStream)
+	: XFontDataStream(inXFont, inSourceStream)
+{
+}
+
+/************************************ Seek ************************************/
+bool XFontRLE1BitDataStream::Seek(
+	int32_t		inOffset,
+	EOrigin		inOrigin)
+{
+	ResetState();
+	return(mSourceStream->Seek(inOffset, inOrigin));
+}
+
+/********************************* ResetState *********************************/
+void XFontRLE1BitDataStream::ResetState(void)
+{
+	XFontDataStream::ResetState();
+	mRunLeft = 0;
+	// The first run of each glyph is a background run from a new byte.
+	mForeground = true;
+}
+
+/*********************************** AtEOF ************************************/
+bool XFontRLE1BitDataStream::AtEOF(void) const
+{
+	return(mSourceStream->AtEOF());
+}
+
+/*********************************** GetPos ***********************************/
+uint32_t XFontRLE1BitDataStream::GetPos(void) const
+{
+	return(mSourceStream->GetPos());
+}
+
+/************************************ Clip ************************************/
+uint32_t XFontRLE1BitDataStream::Clip(
+	uint32_t	inLength) const
+{
+	return(mSourceStream->Clip(inLength));
+}
+
+/********************************** NextRun ***********************************/
+/*
+*	Returns the length of the next run and toggles mForeground.
+*	A zero byte is never written by the encoder.  If one is read, the
+*	remainder of the glyph is treated as background.
+*/
+uint16_t XFontRLE1BitDataStream::NextRun(void)
+{
+	uint16_t	runLength;
+	if (mForeground)
+	{
+		mRunPair = NextByte();
+		mForeground = false;
+		runLength = mRunPair ? (mRunPair >> 4) : 0xFFFF;
+	} else
+	{
+		mForeground = true;
+		runLength = mRunPair & 0x0F;
+	}
+	return(runLength);
+}
+
+/************************************ Read ************************************/
+/*
+*	Expands run length encoded 1 bit glyph data to 565 pixel data.
+*	See XFontGlyph.h for encoding details.
+*/
+uint32_t XFontRLE1BitDataStream::Read(
+	uint32_t	inLength,
+	void*		outBuffer)
+{
+	uint16_t*	oBufferPtr = (uint16_t*)outBuffer;
+	uint16_t*	oBufferEnd = &oBufferPtr[inLength];
+	uint16_t	runLeft = mRunLeft;
+	while (oBufferPtr != oBufferEnd)
+	{
+		if (runLeft == 0)
+		{
+			runLeft = NextRun();
+			continue;
+		}
+		uint16_t	color = DisplayController::NativePixel(
+						mForeground ? mXFont->GetTextColor() : mXFont->GetBGTextColor());
+		for (; oBufferPtr != oBufferEnd && runLeft; runLeft--)
+		{
+			*(oBufferPtr++) = color;
+		}
+	}
+	mRunLeft = runLeft;
+	return(inLength);
+}
+
+/********************************* CopyBlock **********************************/
+/*
+*	Decodes inRows*inColumns pixels directly to the display.  Will fail if it
+*	won't fit (nothing drawn, just fails.)  If successful the current column
+*	is advanced by inColumns.  The current row is left unchanged.
+*/
+bool XFontRLE1BitDataStream::CopyBlock(
+	DisplayController*	inDisplay,
+	uint16_t			inRows,
+	uint16_t			inColumns)
+{
+	bool	success = inDisplay->WillFit(inRows, inColumns);
+	if (success)
+	{
+		uint16_t	pixelsLeft = inRows * inColumns;
+		if (pixelsLeft)
+		{
+			uint16_t	pixels[32];
+			uint8_t		pixelCount = 0;
+			uint16_t	runLeft = mRunLeft;
+			uint16_t	span = 0;
+			uint16_t	spanColor = 0;
+			/*
+			*	The pixels are written with CopyPixels and FillPixels, which
+			*	don't report what they cover, so report the whole block as
+			*	StreamCopyBlock does.
+			*/
+			inDisplay->Cover(inDisplay->GetRow(), inDisplay->GetColumn(), inRows, inColumns);
+			inDisplay->SetColumnRange(inColumns);
+			/*
+			*	Consecutive runs of the same color, such as a run continued
+			*	past 15 pixels, are combined into a single span.
+			*/
+			while (true)
+			{
+				uint16_t	color = mForeground ? mXFont->GetTextColor() : mXFont->GetBGTextColor();
+				/*
+				*	If the span ended THEN
+				*	send it to the display.
+				*/
+				if (span &&
+					(pixelsLeft == 0 || (runLeft && color != spanColor)))
+				{
+					/*
+					*	If this is a long span THEN
+					*	send any pending pixels followed by the span as a fill.
+					*/
+					if (span >= kMinFillRun)
+					{
+						if (pixelCount)
+						{
+							inDisplay->CopyPixels(pixels, pixelCount);
+							pixelCount = 0;
+						}
+						inDisplay->FillPixels(span, spanColor);
+					/*
+					*	Else add the span to the pending pixels.
+					*/
+					} else
+					{
+						uint16_t	nativeColor = DisplayController::NativePixel(spanColor);
+						for (; span; span--)
+						{
+							pixels[pixelCount++] = nativeColor;
+							if (pixelCount == sizeof(pixels)/sizeof(uint16_t))
+							{
+								inDisplay->CopyPixels(pixels, pixelCount);
+								pixelCount = 0;
+							}
+						}
+					}
+					span = 0;
+				}
+				if (pixelsLeft == 0)
+				{
+					break;
+				}
+				if (runLeft == 0)
+				{
+					runLeft = NextRun();
+					continue;
+				}
+				uint16_t	run = runLeft < pixelsLeft ? runLeft : pixelsLeft;
+				runLeft -= run;
+				pixelsLeft -= run;
+				span += run;
+				spanColor = color;
+			}
+			if (pixelCount)
+			{
+				inDisplay->CopyPixels(pixels, pixelCount);
+			}
+			mRunLeft = runLeft;
+			inDisplay->SetColumnRange(0, inDisplay->GetColumns()-1);	// Remove the column range clipping
+			inDisplay->MoveToRow(inDisplay->GetRow());	// Leave the row unchanged
+			inDisplay->MoveColumnBy(inColumns); // Advance by inColumns (or wrap to zero if at or past end)
+		}
+	}
+	return(success);
+}
+
+#ifdef __MACH__
+/*********************************** Encode ***********************************/
+uint16_t XFontRLE1BitDataStream::Encode(
+	const uint8_t*	inPackedData,
+	uint16_t		inRows,
+	uint16_t		inColumns,
+	uint8_t*		outData)
+{
+	uint8_t*	outPtr = outData;
+	uint32_t	pixels = (uint32_t)inRows * inColumns;
+	uint32_t	pixel = 0;
+	while (pixel < pixels)
+	{
+		uint16_t	run[2] = {0};	// background, foreground
+		for (uint8_t i = 0; i < 2; i++)
+		{
+			for (; pixel < pixels &&
+				((inPackedData[pixel/8] << (pixel & 7)) & 0x80) == (i ? 0x80 : 0); pixel++)
+			{
+				run[i]++;
+			}
+		}
+		/*
+		*	Runs longer than 15 are continued in the next byte(s) paired with
+		*	an empty run of the other color.
+		*/
+		for (; run[0] > 15; run[0] -= 15)
+		{
+			*(outPtr++) = 0xF0;
+		}
+		for (; run[1] > 15; run[1] -= 15)
+		{
+			*(outPtr++) = (run[0] << 4) | 0x0F;
+			run[0] = 0;
+		}
+		*(outPtr++) = (run[0] << 4) | run[1];
+	}
+	return(outPtr - outData);
+}
+#endif
@@ -0,0 +1,90 @@
+/*
+*	XFontRLE1BitDataStream.h, Copyright Jonathan Mackey 2023
+*	Class that decodes run length encoded 1 bit data for 16 bit displays.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef XFontRLE1BitDataStream_h
+#define XFontRLE1BitDataStream_h
+
+#include "XFontDataStream.h"
+
+class DisplayController;
+
+/*
+*	Used in place of XFont16BitDataStream for fonts with the
+*	FontHeader.runLength1Bit flag set.  See XFontGlyph.h for the encoding.
+*
+*	Read expands the runs to 565 pixels like XFont16BitDataStream.  XFont
+*	instead calls CopyBlock, which sends runs of kMinFillRun or more pixels
+*	to the display as a single FillPixels.  Shorter runs are collected and
+*	sent using CopyPixels.
+*/
+class XFontRLE1BitDataStream : public XFontDataStream
+{
+public:
+							XFontRLE1BitDataStream(
+								XFont*					inXFont,
+								DataStream*				inSourceStream);
+
+	virtual uint32_t		Read(
+								uint32_t				inLength,
+								void*					outBuffer);
+	virtual uint32_t		Write(
+								uint32_t				inLength,
+								const void*				inBuffer)
+								{return(0);}
+	virtual bool			Seek(
+								int32_t					inOffset,
+								EOrigin					inOrigin);
+	virtual uint32_t		GetPos(void) const;
+	virtual bool			AtEOF(void) const;
+	virtual uint32_t		Clip(
+								uint32_t				inLength) const;
+	virtual void			ResetState(void);
+	/*
+	*	CopyBlock: Same as DisplayController::StreamCopyBlock (horizontal
+	*	addressing only.)
+	*/
+	bool					CopyBlock(
+								DisplayController*		inDisplay,
+								uint16_t				inRows,
+								uint16_t				inColumns);
+#ifdef __MACH__
+	/*
+	*	Encode: Encodes inRows x inColumns of packed 1 bit data.  outData
+	*	should be at least inRows * inColumns bytes (worst case.)  Returns the
+	*	length of the encoded data.
+	*/
+	static uint16_t			Encode(
+								const uint8_t*			inPackedData,
+								uint16_t				inRows,
+								uint16_t				inColumns,
+								uint8_t*				outData);
+#endif
+protected:
+	static const uint8_t	kMinFillRun = 16;
+	// State data
+	uint16_t	mRunLeft;		// Pixels left in the current run
+	uint8_t		mRunPair;		// Byte containing the current run
+	bool		mForeground;	// The current run is foreground
+
+	uint16_t				NextRun(void);
+};
+#endif // XFontRLE1BitDataStream_h